@@ -1,4 +1,17 @@
 #include "ags_private.h"
+#include "ags_drawcount.h"
+#include "ags_emulation.h"
+#include "ags_interposer.h"
+#include "ags_profile.h"
+#include "ags_timing.h"
+
+// Private data of buffers that we already
+// tried to set a placement hint for
+static const GUID dxvkPlacementHintGuid = { 0x3f9a2d64, 0xc1b8, 0x4e07, { 0x9d, 0x5a, 0x62, 0xe1, 0x0b, 0x7c, 0x48, 0x93 } };
+
+// Private data of resources created with AFR transfer
+// hints, storing the packed transfer type and engine
+static const GUID dxvkAfrTransferGuid = { 0x7b2e91c5, 0x04da, 0x4f38, { 0xa6, 0x1f, 0xd3, 0x58, 0x2c, 0x9e, 0x70, 0x1b } };
 
 static ID3D11VkExtContext* dxvkGetContext(
         AGSContext*                   context,
@@ -13,6 +26,92 @@ static ID3D11VkExtContext* dxvkGetContext(
 }
 
 
+static ID3D11Device* dxvkGetDevice(
+        AGSContext*                   context) {
+  ID3D11Device* device = nullptr;
+  context->dxvkDevice->QueryInterface(IID_PPV_ARGS(&device));
+  device->Release();
+  return device;
+}
+
+
+static void dxvkQueryExtInterfaces(
+        AGSContext*                   context) {
+  context->dxvkDevice1  = nullptr;
+  context->dxvkContext1 = nullptr;
+  
+  // DXVK exposes either both or neither, but
+  // treat a partial set as not supported too
+  if (FAILED(context->dxvkDevice ->QueryInterface(IID_PPV_ARGS(&context->dxvkDevice1)))
+   || FAILED(context->dxvkContext->QueryInterface(IID_PPV_ARGS(&context->dxvkContext1)))) {
+    if (context->dxvkDevice1)
+      context->dxvkDevice1->Release();
+    
+    context->dxvkDevice1  = nullptr;
+    context->dxvkContext1 = nullptr;
+    
+    agsLog() << "AGS: DXVK does not support extended interfaces";
+  }
+}
+
+
+static void dxvkReleaseExtInterfaces(
+        AGSContext*                   context) {
+  if (!context->dxvkDevice1)
+    return;
+  
+  context->dxvkDevice1->Release();
+  context->dxvkDevice1 = nullptr;
+  
+  context->dxvkContext1->Release();
+  context->dxvkContext1 = nullptr;
+}
+
+
+static void dxvkCountCall(
+        AGSContext*                   context,
+        AGSTelemetryCall              call) {
+  context->callCounts[call].fetch_add(1, std::memory_order_relaxed);
+}
+
+
+static bool dxvkHasExtension(
+        AGSContext*                   context,
+        D3D11_VK_EXTENSION            extension) {
+  // Everything past barrier control needs the extended
+  // interfaces, even if the base interface reports it
+  if (extension > D3D11_VK_EXT_BARRIER_CONTROL && !context->dxvkDevice1)
+    return false;
+  
+  return context->dxvkDevice->GetExtensionSupport(extension);
+}
+
+
+static bool dxvkIsExtensionEnabled(
+        AGSContext*                   context,
+        D3D11_VK_EXTENSION            extension,
+        unsigned int                  agsExtension) {
+  return (context->extensionMask & agsExtension)
+      && dxvkHasExtension(context, extension);
+}
+
+
+static bool dxvkIsKilled(
+        AGSContext*                   context,
+        AGSTelemetryKillSwitch        killSwitch) {
+  return context->killSwitches.load(std::memory_order_relaxed) & killSwitch;
+}
+
+
+static AGSReturnCode dxvkUnsupported(
+        AGSContext*                   context) {
+  if (context)
+    context->frameCounters.unsupportedCalls.fetch_add(1, std::memory_order_relaxed);
+  
+  return AGS_EXTENSION_NOT_SUPPORTED;
+}
+
+
 static unsigned int dxvkCalcMaxDrawCount(
         ID3D11Buffer*                 pBufferForArgs,
         unsigned int                  alignedByteOffsetForArgs,
@@ -35,28 +134,366 @@ static AGSReturnCode dxvkGetExtensionSupport(
   static const std::vector<std::pair<D3D11_VK_EXTENSION, unsigned int>> extPairs = {{
     { D3D11_VK_EXT_BARRIER_CONTROL,           AGS_DX11_EXTENSION_UAV_OVERLAP },
     { D3D11_VK_EXT_DEPTH_BOUNDS,              AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST },
-    { D3D11_VK_EXT_MULTI_DRAW_INDIRECT,       AGS_DX11_EXTENSION_MULTIDRAWINDIRECT },
     { D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT, AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT },
+    { D3D11_VK_EXT_VIEW_BROADCAST,            AGS_DX11_EXTENSION_MULTIVIEW },
     #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
     { D3D11_VK_EXT_BARRIER_CONTROL,           AGS_DX11_EXTENSION_UAV_OVERLAP_DEFERRED_CONTEXTS },
     { D3D11_VK_EXT_DEPTH_BOUNDS,              AGS_DX11_EXTENSION_DEPTH_BOUNDS_DEFERRED_CONTEXTS },
-    { D3D11_VK_EXT_MULTI_DRAW_INDIRECT,       AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS },
-    { D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT, AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS },
     #endif
   }};
   
-  unsigned int extensions = 0;
+  // We only ever expose a single GPU, for which the
+  // explicit Crossfire API is trivial to implement
+  unsigned int extensions = AGS_DX11_EXTENSION_CROSSFIRE_API;
+  
+  // Multi-Draw Indirect falls back to regular indirect draws
+  // if DXVK does not support it, so that GPU-driven engines
+  // do not turn off their indirect draw path entirely. The
+  // count variant can only be emulated with a lot of empty
+  // draws, so it is only reported if DXVK supports it.
+  extensions |= AGS_DX11_EXTENSION_MULTIDRAWINDIRECT;
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
+  extensions |= AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS;
+  #endif
+  
   for (auto p : extPairs) {
-    if (context->dxvkDevice->GetExtensionSupport(p.first))
+    if (dxvkHasExtension(context, p.first))
       extensions |= p.second;
   }
-
+  
+  extensions |= context->intrinsicExtensions;
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+  if (context->appRegistered)
+    extensions |= AGS_DX11_EXTENSION_APP_REGISTRATION;
+  #endif
+  
+  extensions &= context->extensionMask;
+  
+  context->extensionsSupported = extensions;
   *extensionsSupported = extensions;
   return AGS_SUCCESS;
 }
 
 
+static AGSReturnCode dxvkSetDiskShaderCacheEnabled(
+        AGSContext*                   context,
+        bool                          enable) {
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_STATE_CACHE_CONTROL))
+    return AGS_EXTENSION_NOT_SUPPORTED;
+  
+  if (FAILED(context->dxvkDevice1->SetStateCacheEnabled(enable)))
+    return AGS_FAILURE;
+  
+  return AGS_SUCCESS;
+}
+
+
+static UINT STDMETHODCALLTYPE dxvkScanShaderIntrinsics(
+        void*                         pUserData,
+  const void*                         pShaderBytecode,
+        SIZE_T                        BytecodeLength,
+        UINT                          MaxInstructions,
+        D3D11_VK_SHADER_INTRINSIC_INSTRUCTION* pInstructions,
+        BOOL*                         pUavReleased) {
+  auto context = reinterpret_cast<AGSContext*>(pUserData);
+  
+  *pUavReleased = FALSE;
+  
+  std::vector<DxbcIntrinsic> intrinsics;
+  uint32_t accessCount = 0;
+  
+  if (!dxbcScanIntrinsics(pShaderBytecode, BytecodeLength, 0,
+      context->intrinsicUavSlot, intrinsics, &accessCount))
+    return 0;
+  
+  // Only report intrinsics that we advertise, anything
+  // else remains a regular atomic on the dummy UAV
+  UINT count = 0;
+  
+  for (const auto& intrinsic : intrinsics) {
+    if (intrinsic.opcode >= 64 || !(context->intrinsicOpcodes & (1ull << intrinsic.opcode)))
+      continue;
+    
+    if (pInstructions) {
+      if (count == MaxInstructions)
+        break;
+      
+      D3D11_VK_SHADER_INTRINSIC_INSTRUCTION& dst = pInstructions[count];
+      dst.InstructionOffset = intrinsic.offset;
+      dst.Intrinsic         = D3D11_VK_SHADER_INTRINSIC(intrinsic.opcode);
+      dst.Phase             = intrinsic.phase;
+      dst.Data              = intrinsic.data;
+    }
+    
+    count++;
+  }
+  
+  // The binding is only useless if every access
+  // to the UAV gets replaced by an intrinsic
+  *pUavReleased = count == accessCount;
+  return count;
+}
+
+
+static void dxvkInitShaderIntrinsics(
+        AGSContext*                   context) {
+  // Extensions that cover multiple intrinsics are only
+  // reported if all of the intrinsics are supported
+  static const std::vector<std::pair<D3D11_VK_SHADER_INTRINSIC, unsigned int>> intrinsicPairs = {{
+    { D3D11_VK_SHADER_INTRINSIC_READFIRSTLANE,  AGS_DX11_EXTENSION_INTRINSIC_READFIRSTLANE },
+    { D3D11_VK_SHADER_INTRINSIC_READLANE,       AGS_DX11_EXTENSION_INTRINSIC_READLANE },
+    { D3D11_VK_SHADER_INTRINSIC_LANEID,         AGS_DX11_EXTENSION_INTRINSIC_LANEID },
+    { D3D11_VK_SHADER_INTRINSIC_SWIZZLE,        AGS_DX11_EXTENSION_INTRINSIC_SWIZZLE },
+    { D3D11_VK_SHADER_INTRINSIC_BALLOT,         AGS_DX11_EXTENSION_INTRINSIC_BALLOT },
+    { D3D11_VK_SHADER_INTRINSIC_MBCNT,          AGS_DX11_EXTENSION_INTRINSIC_MBCOUNT },
+    { D3D11_VK_SHADER_INTRINSIC_MIN3U,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_MIN3F,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_MED3U,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_MED3F,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_MAX3U,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_MAX3F,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D11_VK_SHADER_INTRINSIC_BARYCOORD,      AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS },
+    { D3D11_VK_SHADER_INTRINSIC_VTXPARAM,       AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS },
+    #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+    { D3D11_VK_SHADER_INTRINSIC_WAVE_REDUCE,    AGS_DX11_EXTENSION_INTRINSIC_WAVE_REDUCE },
+    { D3D11_VK_SHADER_INTRINSIC_WAVE_SCAN,      AGS_DX11_EXTENSION_INTRINSIC_WAVE_SCAN },
+    #endif
+  }};
+  
+  context->intrinsicExtensions = 0;
+  context->intrinsicOpcodes    = 0;
+  context->intrinsicUavFilter  = false;
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_SHADER_INTRINSICS))
+    return;
+  
+  unsigned int unsupported = 0;
+  
+  for (auto p : intrinsicPairs) {
+    if (context->dxvkDevice1->GetShaderIntrinsicSupport(p.first))
+      context->intrinsicExtensions |= p.second;
+    else
+      unsupported |= p.second;
+  }
+  
+  context->intrinsicExtensions &= ~unsupported;
+  context->intrinsicExtensions &= context->extensionMask;
+  
+  for (auto p : intrinsicPairs) {
+    if (context->intrinsicExtensions & p.second)
+      context->intrinsicOpcodes |= 1ull << p.first;
+  }
+  
+  if (!context->intrinsicOpcodes)
+    return;
+  
+  context->dxvkDevice1->SetShaderIntrinsicHook(
+    context->intrinsicUavSlot,
+    &dxvkScanShaderIntrinsics,
+    context);
+  
+  // Shaders whose intrinsics all get translated no longer
+  // access the reserved UAV, so the placeholder bindings
+  // are useless for them. Unless the profile says so, only
+  // do this for apps that explicitly chose the slot.
+  bool filter = context->uavBindingFilterMode > 0
+    || (context->uavBindingFilterMode < 0 && context->intrinsicUavExplicit);
+  
+  context->intrinsicUavFilter = filter
+    && dxvkHasExtension(context, D3D11_VK_EXT_UAV_BINDING_FILTER);
+  
+  if (context->intrinsicUavFilter) {
+    D3D11_VK_UAV_BINDING_FILTER_STATS stats = { };
+    context->dxvkDevice1->GetUavBindingFilterStats(&stats);
+    context->dxvkDevice1->SetUavBindingFilter(context->intrinsicUavSlot, TRUE);
+    
+    context->uavBindingsFiltered = stats.TotalBindingsFiltered;
+  }
+}
+
+
+static void dxvkResetDeviceState(
+        AGSContext*                   context) {
+  if (context->intrinsicUavFilter) {
+    D3D11_VK_UAV_BINDING_FILTER_STATS stats = { };
+    context->dxvkDevice1->GetUavBindingFilterStats(&stats);
+    context->dxvkDevice1->SetUavBindingFilter(context->intrinsicUavSlot, FALSE);
+    context->intrinsicUavFilter = false;
+    
+    agsLog() << "Intrinsic UAV bindings filtered: " << stats.TotalBindingsFiltered
+             << " total, " << stats.LastFrameBindingsFiltered << " in last frame";
+  }
+  
+  if (context->intrinsicOpcodes)
+    context->dxvkDevice1->SetShaderIntrinsicHook(0, nullptr, nullptr);
+  
+  agsTimingDestroy(context);
+  agsDrawCountDestroy(context);
+  agsEmulationDestroy(context);
+  
+  context->drawCountShadowing = false;
+  context->drawCountBuffers.clear();
+  
+  if (context->placementHints) {
+    D3D11_VK_RESOURCE_PLACEMENT_STATS stats = { };
+    context->dxvkDevice1->GetResourcePlacementStats(&stats);
+    context->placementHints = false;
+    
+    agsLog() << "MDI buffer placement hints: " << context->placementHintsSet.load() << " buffers, "
+             << context->placementHits.load() << " hits, " << stats.BytesNotStaged << " bytes not staged";
+  }
+}
+
+
+static void dxvkInitDeviceState(
+        AGSContext*                   context) {
+  // Apply settings the app made before creating the device.
+  // The state cache is enabled by default, so there is
+  // nothing to do unless the app explicitly disabled it.
+  if (!context->diskShaderCacheEnabled)
+    dxvkSetDiskShaderCacheEnabled(context, false);
+  
+  context->maxClipRects = dxvkHasExtension(context, D3D11_VK_EXT_DISCARD_RECTANGLES)
+    ? context->dxvkDevice1->GetDeviceLimit(D3D11_VK_DEVICE_LIMIT_MAX_DISCARD_RECTANGLES)
+    : 0;
+  
+  context->maxDrawIndirectCount = dxvkHasExtension(context, D3D11_VK_EXT_DRAW_INDIRECT_LIMITS)
+    ? context->dxvkDevice1->GetDeviceLimit(D3D11_VK_DEVICE_LIMIT_MAX_DRAW_INDIRECT_COUNT)
+    : ~0u;
+  
+  if (!context->maxDrawIndirectCount)
+    context->maxDrawIndirectCount = ~0u;
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT))
+    agsLog() << "AGS: Multi-Draw Indirect not supported by DXVK, using emulation";
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT))
+    agsLog() << "AGS: Multi-Draw Indirect Count not supported by DXVK";
+  
+  context->clipRectMode = D3D11_VK_DISCARD_RECTANGLE_MODE_INCLUSIVE;
+  context->clipRects.clear();
+  context->clipRects.reserve(context->maxClipRects);
+  
+  context->placementHints = context->placementHintsEnabled
+    && dxvkHasExtension(context, D3D11_VK_EXT_RESOURCE_PLACEMENT);
+  context->placementHintsSet.store(0, std::memory_order_relaxed);
+  context->placementHits.store(0, std::memory_order_relaxed);
+  
+  dxvkInitShaderIntrinsics(context);
+  
+  agsTimingInit(context);
+  agsDrawCountInit(context);
+}
+
+
+static PFN_D3D11_CREATE_DEVICE_AND_SWAP_CHAIN dxvkGetCreateDeviceProc(
+        AGSContext*                   context) {
+  // Only load d3d11.dll once the app creates a device,
+  // so that loading AGS itself stays cheap
+  if (!context->d3d11Module)
+    context->d3d11Module = LoadLibraryA("d3d11.dll");
+  
+  if (!context->d3d11Module)
+    return nullptr;
+  
+  return reinterpret_cast<PFN_D3D11_CREATE_DEVICE_AND_SWAP_CHAIN>(
+    GetProcAddress(context->d3d11Module, "D3D11CreateDeviceAndSwapChain"));
+}
+
+
 #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+static void dxvkCreateInterposer(
+        AGSContext*                   context,
+        AGSDX11ReturnedParams*        returnedParams) {
+  // The wrappers take over the references that were
+  // returned to us. Objects that don't support the
+  // interfaces we implement are handed out as-is.
+  ID3D11DeviceContext4* ctx = nullptr;
+  
+  if (context->interposerEnabled
+   && SUCCEEDED(returnedParams->pImmediateContext->QueryInterface(IID_PPV_ARGS(&ctx)))) {
+    returnedParams->pImmediateContext->Release();
+    returnedParams->pImmediateContext = new AgsDeviceContext(context, ctx);
+  }
+  
+  // The swap chain is only needed for per-frame work.
+  // Telemetry, GPU timing and adaptive draw counts are
+  // set up by the time we get here.
+  bool perFrame = context->frameStatsEnabled
+    || context->telemetry
+    || context->gpuTiming
+    || context->drawCountTracker;
+  
+  IDXGISwapChain4* swapChain = nullptr;
+  
+  if (perFrame && returnedParams->pSwapChain
+   && SUCCEEDED(returnedParams->pSwapChain->QueryInterface(IID_PPV_ARGS(&swapChain)))) {
+    returnedParams->pSwapChain->Release();
+    returnedParams->pSwapChain = new AgsSwapChain(context, swapChain);
+  }
+}
+
+
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+static void dxvkConvertExtensions(
+        unsigned int                  extensions,
+        AGSDX11ReturnedParams::ExtensionsSupported* result) {
+  // Intrinsics are reported in groups, so only report
+  // a group if every intrinsic in it is supported
+  auto hasAll = [extensions] (unsigned int mask) {
+    return (extensions & mask) == mask;
+  };
+  
+  *result = AGSDX11ReturnedParams::ExtensionsSupported();
+  result->uavOverlap                      = hasAll(AGS_DX11_EXTENSION_UAV_OVERLAP);
+  result->depthBoundsTest                 = hasAll(AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST);
+  result->multiDrawIndirect               = hasAll(AGS_DX11_EXTENSION_MULTIDRAWINDIRECT);
+  result->multiDrawIndirectCountIndirect  = hasAll(AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT);
+  result->crossfireAPI                    = hasAll(AGS_DX11_EXTENSION_CROSSFIRE_API);
+  result->intrinsics16                    = hasAll(AGS_DX11_EXTENSION_INTRINSIC_READFIRSTLANE
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_READLANE
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_LANEID
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_SWIZZLE
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_BALLOT
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_MBCOUNT
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_MED3
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS);
+  result->multiView                       = hasAll(AGS_DX11_EXTENSION_MULTIVIEW);
+  result->intrinsics17                    = hasAll(AGS_DX11_EXTENSION_INTRINSIC_WAVE_REDUCE
+                                                 | AGS_DX11_EXTENSION_INTRINSIC_WAVE_SCAN);
+  result->appRegistration                 = hasAll(AGS_DX11_EXTENSION_APP_REGISTRATION);
+  result->MDIDeferredContexts             = hasAll(AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS);
+  result->UAVOverlapDeferredContexts      = hasAll(AGS_DX11_EXTENSION_UAV_OVERLAP_DEFERRED_CONTEXTS);
+  result->depthBoundsDeferredContexts     = hasAll(AGS_DX11_EXTENSION_DEPTH_BOUNDS_DEFERRED_CONTEXTS);
+}
+#endif
+
+
+static bool dxvkRegisterApplication(
+  const AGSDX11ExtensionParams*       extensionParams) {
+  // The Vulkan instance and device are created along with
+  // the D3D11 device, so this has to happen before that
+  auto pfnRegister = reinterpret_cast<PFN_DXVK_REGISTER_APPLICATION>(
+    GetProcAddress(GetModuleHandleA("dxgi.dll"), "DXVKRegisterApplication"));
+  
+  if (!pfnRegister)
+    return false;
+  
+  D3D11_VK_APPLICATION_INFO info = { };
+  
+  if (extensionParams) {
+    info.pApplicationName   = extensionParams->pAppName;
+    info.ApplicationVersion = extensionParams->appVersion;
+    info.pEngineName        = extensionParams->pEngineName;
+    info.EngineVersion      = extensionParams->engineVersion;
+  }
+  
+  return SUCCEEDED(pfnRegister(&info));
+}
+
+
 static AGSReturnCode dxvkCreateDevice(
         AGSContext*                   context,
   const AGSDX11DeviceCreationParams*  creationParams,
@@ -67,7 +504,26 @@ static AGSReturnCode dxvkCreateDevice(
   
   *returnedParams = AGSDX11ReturnedParams();
   
-  HRESULT hr = D3D11CreateDeviceAndSwapChain(
+  // Engine and app profiles can only be applied now
+  if (extensionParams)
+    agsProfileApply(context, extensionParams->pAppName, extensionParams->pEngineName);
+  
+  // A UAV slot of 0 selects the default slot
+  context->intrinsicUavSlot = extensionParams && extensionParams->uavSlot
+    ? extensionParams->uavSlot : 7;
+  context->intrinsicUavExplicit = extensionParams && extensionParams->uavSlot;
+  
+  context->appRegistered = (context->extensionMask & AGS_DX11_EXTENSION_APP_REGISTRATION)
+    && dxvkRegisterApplication(extensionParams);
+  
+  PFN_D3D11_CREATE_DEVICE_AND_SWAP_CHAIN createDevice = dxvkGetCreateDeviceProc(context);
+  
+  if (!createDevice) {
+    agsLog() << "agsDriverExtensionsDX11_CreateDevice: Failed to load d3d11.dll";
+    return AGS_FAILURE;
+  }
+  
+  HRESULT hr = createDevice(
     creationParams->pAdapter,
     creationParams->DriverType,
     creationParams->Software,
@@ -80,7 +536,11 @@ static AGSReturnCode dxvkCreateDevice(
       ? &returnedParams->pSwapChain
       : nullptr,
     &returnedParams->pDevice,
+    #if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+    &returnedParams->featureLevel,
+    #else
     &returnedParams->FeatureLevel,
+    #endif
     &returnedParams->pImmediateContext);
   
   if (FAILED(hr))
@@ -97,13 +557,28 @@ static AGSReturnCode dxvkCreateDevice(
     return AGS_FAILURE;
   }
   
+  dxvkQueryExtInterfaces(context);
+  dxvkInitDeviceState(context);
+  
   // Gather supported extensions
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+  unsigned int extensions = 0;
+  AGSReturnCode ar = dxvkGetExtensionSupport(context, &extensions);
+  dxvkConvertExtensions(extensions, &returnedParams->extensionsSupported);
+  #else
   AGSReturnCode ar = dxvkGetExtensionSupport(context, &returnedParams->extensionsSupported);
-
+  #endif
+  
   if (ar != AGS_SUCCESS)
     return ar;
   
-  std::cerr << "agsDriverExtensionsDX11_CreateDevice() = AGS_SUCCESS" << std::endl;
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 2, 0)
+  returnedParams->crossfireGPUCount = 1;
+  #endif
+  
+  dxvkCreateInterposer(context, returnedParams);
+  
+  agsLog() << "agsDriverExtensionsDX11_CreateDevice() = AGS_SUCCESS";
   return AGS_SUCCESS;
 }
 
@@ -117,6 +592,9 @@ static AGSReturnCode dxvkDestroyDevice(
   if (!context || !context->dxvkDevice)
     return AGS_INVALID_ARGS;
   
+  dxvkResetDeviceState(context);
+  dxvkReleaseExtInterfaces(context);
+  
   // what are we supposed to do with device / immediateContext?
   unsigned int devRefCount = context->dxvkDevice->Release();
   unsigned int ctxRefCount = context->dxvkContext->Release();
@@ -136,20 +614,27 @@ static AGSReturnCode dxvkDestroyDevice(
 
 static AGSReturnCode dxvkAcquireDevice(
         AGSContext*                   context,
-        ID3D11Device*                 device) {
+        ID3D11Device*                 device,
+        unsigned int                  uavSlot) {
   if (!context || !device || context->dxvkDevice)
     return AGS_INVALID_ARGS;
   
+  context->intrinsicUavSlot     = uavSlot;
+  context->intrinsicUavExplicit = true;
+  
   HRESULT hr = device->QueryInterface(IID_PPV_ARGS(&context->dxvkDevice));
-
+  
   if (FAILED(hr))
     return AGS_FAILURE;
   
   ID3D11DeviceContext* ctx = nullptr;
   device->GetImmediateContext(&ctx);
-
+  
   ctx->QueryInterface(IID_PPV_ARGS(&context->dxvkContext));
   ctx->Release();
+  
+  dxvkQueryExtInterfaces(context);
+  dxvkInitDeviceState(context);
   return AGS_SUCCESS;
 }
 
@@ -159,9 +644,12 @@ static AGSReturnCode dxvkReleaseDevice(
   if (!context || !context->dxvkDevice)
     return AGS_INVALID_ARGS;
   
+  dxvkResetDeviceState(context);
+  dxvkReleaseExtInterfaces(context);
+  
   context->dxvkDevice->Release();
   context->dxvkDevice = nullptr;
-
+  
   context->dxvkContext->Release();
   context->dxvkContext = nullptr;
   return AGS_SUCCESS;
@@ -169,129 +657,508 @@ static AGSReturnCode dxvkReleaseDevice(
 
 
 static AGSReturnCode dxvkBeginUAVOverlap(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_BARRIER_CONTROL))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext) {
+  dxvkCountCall(context, AGSTelemetryCallBeginUAVOverlap);
+  
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_BARRIER_CONTROL, AGS_DX11_EXTENSION_UAV_OVERLAP))
+    return dxvkUnsupported(context);
+  
+  if (context->gpuTiming)
+    agsTimingBeginUAVOverlap(context, dxvkContext);
   
-  context->SetBarrierControl(D3D11_VK_BARRIER_CONTROL_IGNORE_WRITE_AFTER_WRITE);
+  // Keeping all barriers is a valid implementation
+  if (!dxvkIsKilled(context, AGSTelemetryKillUAVOverlap))
+    dxvkContext->SetBarrierControl(D3D11_VK_BARRIER_CONTROL_IGNORE_WRITE_AFTER_WRITE);
+  
+  context->frameCounters.uavOverlapScopes.fetch_add(1, std::memory_order_relaxed);
   return AGS_SUCCESS;
 }
 
 
 static AGSReturnCode dxvkEndUAVOverlap(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_BARRIER_CONTROL))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext) {
+  dxvkCountCall(context, AGSTelemetryCallEndUAVOverlap);
   
-  context->SetBarrierControl(0);
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_BARRIER_CONTROL, AGS_DX11_EXTENSION_UAV_OVERLAP))
+    return dxvkUnsupported(context);
+  
+  dxvkContext->SetBarrierControl(0);
+  
+  if (context->gpuTiming)
+    agsTimingEndUAVOverlap(context, dxvkContext);
   return AGS_SUCCESS;
 }
 
 
 static AGSReturnCode dxvkSetDepthBounds(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context,
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
         bool                          enabled,
         float                         minDepth,
         float                         maxDepth) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_DEPTH_BOUNDS))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+  dxvkCountCall(context, AGSTelemetryCallSetDepthBounds);
+  
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_DEPTH_BOUNDS, AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST))
+    return dxvkUnsupported(context);
+  
+  // The app resets the depth bounds on its next call
+  // after the kill switch was turned off again
+  if (dxvkIsKilled(context, AGSTelemetryKillDepthBounds))
+    dxvkContext->SetDepthBoundsTest(FALSE, 0.0f, 1.0f);
+  else
+    dxvkContext->SetDepthBoundsTest(enabled, minDepth, maxDepth);
+  
+  if (context->depthBoundsEnabled.exchange(enabled, std::memory_order_relaxed) != enabled)
+    context->frameCounters.depthBoundsToggles.fetch_add(1, std::memory_order_relaxed);
+  return AGS_SUCCESS;
+}
+
+
+static AGSReturnCode dxvkSetViewBroadcastMasks(
+        AGSContext*                   context,
+        ID3D11VkExtContext1*          dxvkContext,
+        unsigned long long            vpMask,
+        unsigned long long            rtSliceMask,
+        bool                          vpMaskPerRtSliceEnabled) {
+  dxvkCountCall(context, AGSTelemetryCallSetViewBroadcastMasks);
+  
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_VIEW_BROADCAST, AGS_DX11_EXTENSION_MULTIVIEW))
+    return dxvkUnsupported(context);
+  
+  dxvkContext->SetViewBroadcastMasks(vpMask, rtSliceMask, vpMaskPerRtSliceEnabled);
+  return AGS_SUCCESS;
+}
+
+
+static AGSReturnCode dxvkSetClipRects(
+        AGSContext*                   context,
+        unsigned int                  clipRectCount,
+  const AGSClipRect*                  clipRects) {
+  dxvkCountCall(context, AGSTelemetryCallSetClipRects);
+  
+  if (!context->maxClipRects)
+    return dxvkUnsupported(context);
+  
+  if (clipRectCount > context->maxClipRects || (clipRectCount && !clipRects))
+    return AGS_INVALID_ARGS;
+  
+  // Vulkan only supports one mode for all rectangles
+  auto mode = clipRectCount && clipRects[0].mode == AGSClipRect::ClipRectExcluded
+    ? D3D11_VK_DISCARD_RECTANGLE_MODE_EXCLUSIVE
+    : D3D11_VK_DISCARD_RECTANGLE_MODE_INCLUSIVE;
+  
+  for (unsigned int i = 1; i < clipRectCount; i++) {
+    if (clipRects[i].mode != clipRects[0].mode)
+      return dxvkUnsupported(context);
+  }
+  
+  // Filter out redundant updates, which are common
+  // when apps set clip rects for every UI draw
+  bool dirty = mode != context->clipRectMode
+            || clipRectCount != context->clipRects.size();
+  
+  for (unsigned int i = 0; i < clipRectCount; i++) {
+    D3D11_RECT rect;
+    rect.left   = clipRects[i].rect.offsetX;
+    rect.top    = clipRects[i].rect.offsetY;
+    rect.right  = clipRects[i].rect.offsetX + clipRects[i].rect.width;
+    rect.bottom = clipRects[i].rect.offsetY + clipRects[i].rect.height;
+    
+    if (i < context->clipRects.size()) {
+      D3D11_RECT& prev = context->clipRects[i];
+      
+      dirty |= prev.left  != rect.left  || prev.top    != rect.top
+            || prev.right != rect.right || prev.bottom != rect.bottom;
+      prev = rect;
+    } else {
+      context->clipRects.push_back(rect);
+    }
+  }
   
-  context->SetDepthBoundsTest(enabled, minDepth, maxDepth);
+  if (!dirty && context->clipRectFilterEnabled)
+    return AGS_SUCCESS;
+  
+  context->clipRects.resize(clipRectCount);
+  context->clipRectMode = mode;
+  
+  context->dxvkContext1->SetDiscardRectangles(
+    clipRectCount, context->clipRects.data(), mode);
   return AGS_SUCCESS;
 }
 
 
+static void dxvkRecordAfrTransfer(
+        AGSContext*                   context,
+        ID3D11Resource*               resource,
+        AGSAfrTransferType            transferType,
+        AGSAfrTransferEngine          transferEngine) {
+  dxvkCountCall(context, AGSTelemetryCallCreateResource);
+  
+  context->afrStats.resourcesCreated.fetch_add(1, std::memory_order_relaxed);
+  
+  // Most resources use the default behaviour, so only
+  // remember the ones that actually come with a hint.
+  if (transferType == AGS_AFR_TRANSFER_DEFAULT
+   && transferEngine == AGS_AFR_TRANSFERENGINE_DEFAULT)
+    return;
+  
+  context->afrStats.resourcesWithHints.fetch_add(1, std::memory_order_relaxed);
+  
+  // Keep the hint on the resource itself so that
+  // it goes away together with the resource
+  uint8_t transfer = uint8_t(transferType | (transferEngine << 4));
+  resource->SetPrivateData(dxvkAfrTransferGuid, sizeof(transfer), &transfer);
+}
+
+
+static void dxvkDrawIndirect(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  drawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs) {
+  // A single draw does not need any of the MDI machinery
+  if (drawCount == 1) {
+    ID3D11DeviceContext* dxContext = nullptr;
+    dxvkContext->QueryInterface(IID_PPV_ARGS(&dxContext));
+    dxContext->Release();
+    
+    if (indexed)
+      dxContext->DrawIndexedInstancedIndirect(pBufferForArgs, alignedByteOffsetForArgs);
+    else
+      dxContext->DrawInstancedIndirect(pBufferForArgs, alignedByteOffsetForArgs);
+    
+    context->mdiShaping.callsDemoted.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  
+  unsigned int maxDrawCount = context->maxDrawIndirectCount;
+  
+  if (drawCount > maxDrawCount)
+    context->mdiShaping.callsSplit.fetch_add(1, std::memory_order_relaxed);
+  
+  for (unsigned int first = 0; first < drawCount; first += maxDrawCount) {
+    unsigned int count  = std::min(drawCount - first, maxDrawCount);
+    unsigned int offset = alignedByteOffsetForArgs + first * byteStrideForArgs;
+    
+    if (indexed)
+      dxvkContext->MultiDrawIndexedIndirect(count, pBufferForArgs, offset, byteStrideForArgs);
+    else
+      dxvkContext->MultiDrawIndirect(count, pBufferForArgs, offset, byteStrideForArgs);
+  }
+}
+
+
+static void dxvkHintPlacement(
+        AGSContext*                   context,
+        ID3D11Buffer*                 buffer) {
+  if (!context->placementHints)
+    return;
+  
+  // Private data is thread-safe, so only the first use
+  // of a buffer needs to lock, in order to classify it
+  // and set the hint exactly once
+  UINT hinted = 0;
+  UINT size   = sizeof(hinted);
+  
+  if (SUCCEEDED(buffer->GetPrivateData(dxvkPlacementHintGuid, &size, &hinted))) {
+    if (hinted)
+      context->placementHits.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  
+  std::lock_guard<std::mutex> lock(context->placementMutex);
+  
+  size = sizeof(hinted);
+  
+  if (SUCCEEDED(buffer->GetPrivateData(dxvkPlacementHintGuid, &size, &hinted)))
+    return;
+  
+  // Args and count buffers are usually written by the CPU
+  // every frame. Buffers that the GPU writes to are better
+  // off in regular video memory, so leave those alone.
+  D3D11_BUFFER_DESC desc;
+  buffer->GetDesc(&desc);
+  
+  hinted = desc.Usage != D3D11_USAGE_IMMUTABLE
+    && !(desc.BindFlags & (D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_STREAM_OUTPUT))
+    && context->dxvkDevice1->SetResourcePlacementHint(buffer,
+      D3D11_VK_RESOURCE_PLACEMENT_HOST_VISIBLE_VRAM) == S_OK;
+  
+  buffer->SetPrivateData(dxvkPlacementHintGuid, sizeof(hinted), &hinted);
+  
+  if (hinted)
+    context->placementHintsSet.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+static unsigned int dxvkClampDrawCount(
+        AGSContext*                   context,
+        unsigned int                  maxDrawCount) {
+  // The draw count read from the buffer must not exceed
+  // the device limit either, so this drops no valid draws
+  if (maxDrawCount <= context->maxDrawIndirectCount)
+    return maxDrawCount;
+  
+  context->mdiShaping.callsClamped.fetch_add(1, std::memory_order_relaxed);
+  return context->maxDrawIndirectCount;
+}
+
+
 static AGSReturnCode dxvkMultiDrawIndirect(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context,
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
         unsigned int                  drawCount,
         ID3D11Buffer*                 pBufferForArgs,
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_MULTI_DRAW_INDIRECT))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+  dxvkCountCall(context, AGSTelemetryCallMultiDrawIndirect);
   
-  context->MultiDrawIndirect(
-    drawCount,
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  if (!(context->extensionMask & AGS_DX11_EXTENSION_MULTIDRAWINDIRECT))
+    return dxvkUnsupported(context);
+  
+  // Empty calls would still flush state in DXVK
+  if (!drawCount || !pBufferForArgs) {
+    context->mdiShaping.callsElided.fetch_add(1, std::memory_order_relaxed);
+    return AGS_SUCCESS;
+  }
+  
+  dxvkHintPlacement(context, pBufferForArgs);
+  
+  uint32_t timing = agsTimingBegin(context, dxvkContext,
+    AGSTelemetryCallMultiDrawIndirect, pBufferForArgs, alignedByteOffsetForArgs);
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT)
+   || dxvkIsKilled(context, AGSTelemetryKillMultiDrawIndirect)) {
+    agsEmulateMultiDrawIndirect(context, dxvkContext, false,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+    context->mdiShaping.callsEmulated.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dxvkDrawIndirect(context, dxvkContext, false,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+  }
+  
+  agsTimingEnd(context, timing);
+  
+  context->frameCounters.mdiCalls.fetch_add(1, std::memory_order_relaxed);
+  context->frameCounters.mdiDraws.fetch_add(drawCount, std::memory_order_relaxed);
   return AGS_SUCCESS;
 }
 
 
 static AGSReturnCode dxvkMultiDrawIndexedIndirect(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context,
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
         unsigned int                  drawCount,
         ID3D11Buffer*                 pBufferForArgs,
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_MULTI_DRAW_INDIRECT))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+  dxvkCountCall(context, AGSTelemetryCallMultiDrawIndexedIndirect);
   
-  context->MultiDrawIndexedIndirect(
-    drawCount,
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  if (!(context->extensionMask & AGS_DX11_EXTENSION_MULTIDRAWINDIRECT))
+    return dxvkUnsupported(context);
+  
+  // Empty calls would still flush state in DXVK
+  if (!drawCount || !pBufferForArgs) {
+    context->mdiShaping.callsElided.fetch_add(1, std::memory_order_relaxed);
+    return AGS_SUCCESS;
+  }
+  
+  dxvkHintPlacement(context, pBufferForArgs);
+  
+  uint32_t timing = agsTimingBegin(context, dxvkContext,
+    AGSTelemetryCallMultiDrawIndexedIndirect, pBufferForArgs, alignedByteOffsetForArgs);
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT)
+   || dxvkIsKilled(context, AGSTelemetryKillMultiDrawIndirect)) {
+    agsEmulateMultiDrawIndirect(context, dxvkContext, true,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+    context->mdiShaping.callsEmulated.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dxvkDrawIndirect(context, dxvkContext, true,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+  }
+  
+  agsTimingEnd(context, timing);
+  
+  context->frameCounters.mdiCalls.fetch_add(1, std::memory_order_relaxed);
+  context->frameCounters.mdiDraws.fetch_add(drawCount, std::memory_order_relaxed);
+  return AGS_SUCCESS;
+}
+
+
+static AGSReturnCode dxvkMultiDrawKnownCount(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  drawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs) {
+  context->mdiShaping.callsResolved.fetch_add(1, std::memory_order_relaxed);
+  context->frameCounters.mdiCountCalls.fetch_add(1, std::memory_order_relaxed);
+  
+  if (!drawCount) {
+    context->mdiShaping.callsElided.fetch_add(1, std::memory_order_relaxed);
+    return AGS_SUCCESS;
+  }
+  
+  uint32_t timing = agsTimingBegin(context, dxvkContext, indexed
+    ? AGSTelemetryCallMultiDrawIndexedIndirectCount
+    : AGSTelemetryCallMultiDrawIndirectCount,
+    pBufferForArgs, alignedByteOffsetForArgs);
+  
+  if (!dxvkHasExtension(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT)
+   || dxvkIsKilled(context, AGSTelemetryKillMultiDrawIndirectCount)) {
+    agsEmulateMultiDrawIndirect(context, dxvkContext, indexed,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+    context->mdiShaping.callsEmulated.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dxvkDrawIndirect(context, dxvkContext, indexed,
+      drawCount, pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+  }
+  
+  agsTimingEnd(context, timing);
   return AGS_SUCCESS;
 }
 
 
 static AGSReturnCode dxvkMultiDrawIndirectCount(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context,
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
         ID3D11Buffer*                 pBufferForDrawCount,
         unsigned int                  alignedByteOffsetForDrawCount,
         ID3D11Buffer*                 pBufferForArgs,
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+  dxvkCountCall(context, AGSTelemetryCallMultiDrawIndirectCount);
   
-  unsigned int maxDrawCount = dxvkCalcMaxDrawCount(
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT, AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT))
+    return dxvkUnsupported(context);
   
-  context->MultiDrawIndirectCount(
-    maxDrawCount,
-    pBufferForDrawCount,
-    alignedByteOffsetForDrawCount,
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  unsigned int maxDrawCount = pBufferForArgs && pBufferForDrawCount
+    ? dxvkCalcMaxDrawCount(pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs)
+    : 0;
+  
+  if (!maxDrawCount) {
+    context->mdiShaping.callsElided.fetch_add(1, std::memory_order_relaxed);
+    return AGS_SUCCESS;
+  }
+  
+  dxvkHintPlacement(context, pBufferForArgs);
+  dxvkHintPlacement(context, pBufferForDrawCount);
+  
+  // Skip the count path entirely if the CPU wrote the count
+  uint32_t drawCount = 0;
+  
+  if (agsInterposerGetDrawCount(context, dxvkContext,
+      pBufferForDrawCount, alignedByteOffsetForDrawCount, &drawCount)) {
+    return dxvkMultiDrawKnownCount(context, dxvkContext, false,
+      std::min(drawCount, maxDrawCount), pBufferForArgs,
+      alignedByteOffsetForArgs, byteStrideForArgs);
+  }
+  
+  maxDrawCount = dxvkClampDrawCount(context, maxDrawCount);
+  maxDrawCount = agsDrawCountAdapt(context, dxvkContext,
+    pBufferForDrawCount, alignedByteOffsetForDrawCount, maxDrawCount);
+  
+  uint32_t timing = agsTimingBegin(context, dxvkContext,
+    AGSTelemetryCallMultiDrawIndirectCount, pBufferForArgs, alignedByteOffsetForArgs);
+  
+  // Only emulate if the extension is switched off, and
+  // keep using it if emulation is not possible
+  bool emulated = dxvkIsKilled(context, AGSTelemetryKillMultiDrawIndirectCount)
+    && agsEmulateMultiDrawIndirectCount(context, dxvkContext, false,
+      maxDrawCount, pBufferForDrawCount, alignedByteOffsetForDrawCount,
+      pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+  
+  if (emulated) {
+    context->mdiShaping.callsEmulated.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dxvkContext->MultiDrawIndirectCount(
+      maxDrawCount,
+      pBufferForDrawCount,
+      alignedByteOffsetForDrawCount,
+      pBufferForArgs,
+      alignedByteOffsetForArgs,
+      byteStrideForArgs);
+  }
+  
+  agsTimingEnd(context, timing);
+  
+  context->frameCounters.mdiCountCalls.fetch_add(1, std::memory_order_relaxed);
   return AGS_SUCCESS;
 }
 
 
 static AGSReturnCode dxvkMultiDrawIndexedIndirectCount(
-        ID3D11VkExtDevice*            device,
-        ID3D11VkExtContext*           context,
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
         ID3D11Buffer*                 pBufferForDrawCount,
         unsigned int                  alignedByteOffsetForDrawCount,
         ID3D11Buffer*                 pBufferForArgs,
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
-  if (!device->GetExtensionSupport(D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT))
-    return AGS_EXTENSION_NOT_SUPPORTED;
+  dxvkCountCall(context, AGSTelemetryCallMultiDrawIndexedIndirectCount);
   
-  unsigned int maxDrawCount = dxvkCalcMaxDrawCount(
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  if (!dxvkIsExtensionEnabled(context, D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT, AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT))
+    return dxvkUnsupported(context);
   
-  context->MultiDrawIndexedIndirectCount(
-    maxDrawCount,
-    pBufferForDrawCount,
-    alignedByteOffsetForDrawCount,
-    pBufferForArgs,
-    alignedByteOffsetForArgs,
-    byteStrideForArgs);
+  unsigned int maxDrawCount = pBufferForArgs && pBufferForDrawCount
+    ? dxvkCalcMaxDrawCount(pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs)
+    : 0;
+  
+  if (!maxDrawCount) {
+    context->mdiShaping.callsElided.fetch_add(1, std::memory_order_relaxed);
+    return AGS_SUCCESS;
+  }
+  
+  dxvkHintPlacement(context, pBufferForArgs);
+  dxvkHintPlacement(context, pBufferForDrawCount);
+  
+  // Skip the count path entirely if the CPU wrote the count
+  uint32_t drawCount = 0;
+  
+  if (agsInterposerGetDrawCount(context, dxvkContext,
+      pBufferForDrawCount, alignedByteOffsetForDrawCount, &drawCount)) {
+    return dxvkMultiDrawKnownCount(context, dxvkContext, true,
+      std::min(drawCount, maxDrawCount), pBufferForArgs,
+      alignedByteOffsetForArgs, byteStrideForArgs);
+  }
+  
+  maxDrawCount = dxvkClampDrawCount(context, maxDrawCount);
+  maxDrawCount = agsDrawCountAdapt(context, dxvkContext,
+    pBufferForDrawCount, alignedByteOffsetForDrawCount, maxDrawCount);
+  
+  uint32_t timing = agsTimingBegin(context, dxvkContext,
+    AGSTelemetryCallMultiDrawIndexedIndirectCount, pBufferForArgs, alignedByteOffsetForArgs);
+  
+  // Only emulate if the extension is switched off, and
+  // keep using it if emulation is not possible
+  bool emulated = dxvkIsKilled(context, AGSTelemetryKillMultiDrawIndirectCount)
+    && agsEmulateMultiDrawIndirectCount(context, dxvkContext, true,
+      maxDrawCount, pBufferForDrawCount, alignedByteOffsetForDrawCount,
+      pBufferForArgs, alignedByteOffsetForArgs, byteStrideForArgs);
+  
+  if (emulated) {
+    context->mdiShaping.callsEmulated.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    dxvkContext->MultiDrawIndexedIndirectCount(
+      maxDrawCount,
+      pBufferForDrawCount,
+      alignedByteOffsetForDrawCount,
+      pBufferForArgs,
+      alignedByteOffsetForArgs,
+      byteStrideForArgs);
+  }
+  
+  agsTimingEnd(context, timing);
+  
+  context->frameCounters.mdiCountCalls.fetch_add(1, std::memory_order_relaxed);
   return AGS_SUCCESS;
 }
 
@@ -349,8 +1216,8 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_Init(
         ID3D11Device*                 device,
         unsigned int                  uavSlot,
         unsigned int*                 extensionsSupported) {
-  AGSReturnCode ar = dxvkAcquireDevice(context, device);
-
+  AGSReturnCode ar = dxvkAcquireDevice(context, device, uavSlot);
+  
   if (ar == AGS_SUCCESS && extensionsSupported)
     ar = dxvkGetExtensionSupport(context, extensionsSupported);
   
@@ -368,8 +1235,8 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_DeInit(
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_WriteBreadcrumb(
         AGSContext*                   context,
   const AGSBreadcrumbMarker*          marker) {
-  std::cerr << "agsDriverExtensionsDX11_WriteBreadcrumb: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  agsLog() << "agsDriverExtensionsDX11_WriteBreadcrumb: Not implemented";
+  return dxvkUnsupported(context);
 }
 #endif
 
@@ -377,8 +1244,8 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_WriteBreadcrumb(
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_IASetPrimitiveTopology(
         AGSContext*                   context,
         D3D_PRIMITIVE_TOPOLOGY        topology) {
-  std::cerr << "agsDriverExtensionsDX11_IASetPrimitiveTopology: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  agsLog() << "agsDriverExtensionsDX11_IASetPrimitiveTopology: Not implemented";
+  return dxvkUnsupported(context);
 }
 
 
@@ -387,7 +1254,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_BeginUAVOverlap(
         AGSContext*                   context,
         ID3D11DeviceContext*          dxContext) {
   return dxvkBeginUAVOverlap(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext));
 }
 
@@ -396,7 +1263,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_EndUAVOverlap(
         AGSContext*                   context,
         ID3D11DeviceContext*          dxContext) {
   return dxvkEndUAVOverlap(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext));
 }
 
@@ -408,7 +1275,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetDepthBounds(
         float                         minDepth,
         float                         maxDepth) {
   return dxvkSetDepthBounds(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext),
     enabled, minDepth, maxDepth);
 }
@@ -422,7 +1289,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawInstancedIn
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndirect(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext),
     drawCount,
     pBufferForArgs,
@@ -439,7 +1306,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndexedIndirect(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext),
     drawCount,
     pBufferForArgs,
@@ -457,7 +1324,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawInstancedIn
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndirectCount(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext),
     pBufferForDrawCount,
     alignedByteOffsetForDrawCount,
@@ -476,7 +1343,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndexedIndirectCount(
-    context->dxvkDevice,
+    context,
     dxvkGetContext(context, dxContext),
     pBufferForDrawCount,
     alignedByteOffsetForDrawCount,
@@ -488,7 +1355,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_BeginUAVOverlap(
         AGSContext*                   context) {
   return dxvkBeginUAVOverlap(
-    context->dxvkDevice,
+    context,
     context->dxvkContext);
 }
 
@@ -496,7 +1363,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_BeginUAVOverlap(
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_EndUAVOverlap(
         AGSContext*                   context) {
   return dxvkEndUAVOverlap(
-    context->dxvkDevice,
+    context,
     context->dxvkContext);
 }
 
@@ -507,7 +1374,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetDepthBounds(
         float                         minDepth,
         float                         maxDepth) {
   return dxvkSetDepthBounds(
-    context->dxvkDevice,
+    context,
     context->dxvkContext,
     enabled, minDepth, maxDepth);
 }
@@ -520,7 +1387,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawInstancedIn
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndirect(
-    context->dxvkDevice,
+    context,
     context->dxvkContext,
     drawCount,
     pBufferForArgs,
@@ -536,7 +1403,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndexedIndirect(
-    context->dxvkDevice,
+    context,
     context->dxvkContext,
     drawCount,
     pBufferForArgs,
@@ -553,7 +1420,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawInstancedIn
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndirectCount(
-    context->dxvkDevice,
+    context,
     context->dxvkContext,
     pBufferForDrawCount,
     alignedByteOffsetForDrawCount,
@@ -571,7 +1438,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
         unsigned int                  alignedByteOffsetForArgs,
         unsigned int                  byteStrideForArgs) {
   return dxvkMultiDrawIndexedIndirectCount(
-    context->dxvkDevice,
+    context,
     context->dxvkContext,
     pBufferForDrawCount,
     alignedByteOffsetForDrawCount,
@@ -585,24 +1452,34 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_MultiDrawIndexedInst
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetMaxAsyncCompileThreadCount(
         AGSContext*                   context,
         unsigned int                  numberOfThreads) {
-  std::cerr << "agsDriverExtensionsDX11_SetMaxAsyncCompileThreadCount: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  agsLog() << "agsDriverExtensionsDX11_SetMaxAsyncCompileThreadCount: Not implemented";
+  return dxvkUnsupported(context);
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_NumPendingAsyncCompileJobs(
         AGSContext*                   context,
         unsigned int*                 numberOfJobs) {
-  std::cerr << "agsDriverExtensionsDX11_NumPendingAsyncCompileJobs: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  agsLog() << "agsDriverExtensionsDX11_NumPendingAsyncCompileJobs: Not implemented";
+  return dxvkUnsupported(context);
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetDiskShaderCacheEnabled(
         AGSContext*                   context,
         int                           enable) {
-  std::cerr << "agsDriverExtensionsDX11_SetDiskShaderCacheEnabled: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context)
+    return AGS_INVALID_ARGS;
+  
+  context->diskShaderCacheEnabled = enable != 0;
+  
+  // The setting gets applied once the device is created
+  if (!context->dxvkDevice)
+    return AGS_SUCCESS;
+  
+  return dxvkSetDiskShaderCacheEnabled(
+    context,
+    context->diskShaderCacheEnabled);
 }
 
 
@@ -611,16 +1488,25 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetViewBroadcastMask
         unsigned long long            vpMask,
         unsigned long long            rtSliceMask,
         int                           vpMaskPerRtSliceEnabled) {
-  std::cerr << "agsDriverExtensionsDX11_SetViewBroadcastMasks: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  return dxvkSetViewBroadcastMasks(
+    context,
+    context->dxvkContext1,
+    vpMask, rtSliceMask,
+    vpMaskPerRtSliceEnabled != 0);
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_GetMaxClipRects(
         AGSContext*                   context,
         unsigned int*                 maxRectCount) {
-  std::cerr << "agsDriverExtensionsDX11_GetMaxClipRects: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice || !maxRectCount)
+    return AGS_INVALID_ARGS;
+  
+  if (!context->maxClipRects)
+    return dxvkUnsupported(context);
+  
+  *maxRectCount = context->maxClipRects;
+  return AGS_SUCCESS;
 }
 
 
@@ -628,8 +1514,11 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_SetClipRects(
         AGSContext*                   context,
         unsigned int                  clipRectCount,
   const AGSClipRect*                  clipRects) {
-  std::cerr << "agsDriverExtensionsDX11_SetClipRects: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice)
+    return AGS_INVALID_ARGS;
+  
+  return dxvkSetClipRects(context,
+    clipRectCount, clipRects);
 }
 
 
@@ -640,8 +1529,14 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_CreateBuffer(
         ID3D11Buffer**                buffer,
         AGSAfrTransferType            transferType,
         AGSAfrTransferEngine          transferEngine) {
-  std::cerr << "agsDriverExtensionsDX11_CreateBuffer: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice || !desc || !buffer)
+    return AGS_INVALID_ARGS;
+  
+  if (FAILED(dxvkGetDevice(context)->CreateBuffer(desc, initialData, buffer)))
+    return AGS_FAILURE;
+  
+  dxvkRecordAfrTransfer(context, *buffer, transferType, transferEngine);
+  return AGS_SUCCESS;
 }
 
 
@@ -652,8 +1547,14 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_CreateTexture1D(
         ID3D11Texture1D**             texture1D,
         AGSAfrTransferType            transferType,
         AGSAfrTransferEngine          transferEngine) {
-  std::cerr << "agsDriverExtensionsDX11_CreateTexture1D: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice || !desc || !texture1D)
+    return AGS_INVALID_ARGS;
+  
+  if (FAILED(dxvkGetDevice(context)->CreateTexture1D(desc, initialData, texture1D)))
+    return AGS_FAILURE;
+  
+  dxvkRecordAfrTransfer(context, *texture1D, transferType, transferEngine);
+  return AGS_SUCCESS;
 }
 
 
@@ -664,8 +1565,14 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_CreateTexture2D(
         ID3D11Texture2D**             texture2D,
         AGSAfrTransferType            transferType,
         AGSAfrTransferEngine          transferEngine) {
-  std::cerr << "agsDriverExtensionsDX11_CreateTexture2D: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice || !desc || !texture2D)
+    return AGS_INVALID_ARGS;
+  
+  if (FAILED(dxvkGetDevice(context)->CreateTexture2D(desc, initialData, texture2D)))
+    return AGS_FAILURE;
+  
+  dxvkRecordAfrTransfer(context, *texture2D, transferType, transferEngine);
+  return AGS_SUCCESS;
 }
 
 
@@ -676,8 +1583,14 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_CreateTexture3D(
         ID3D11Texture3D**             texture3D,
         AGSAfrTransferType            transferType,
         AGSAfrTransferEngine          transferEngine) {
-  std::cerr << "agsDriverExtensionsDX11_CreateTexture3D: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context || !context->dxvkDevice || !desc || !texture3D)
+    return AGS_INVALID_ARGS;
+  
+  if (FAILED(dxvkGetDevice(context)->CreateTexture3D(desc, initialData, texture3D)))
+    return AGS_FAILURE;
+  
+  dxvkRecordAfrTransfer(context, *texture3D, transferType, transferEngine);
+  return AGS_SUCCESS;
 }
 
 
@@ -687,24 +1600,39 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_NotifyResourceEndWri
   const D3D11_RECT*                   transferRegions,
   const unsigned int*                 subresourceArray,
         unsigned int                  numSubresources) {
-  std::cerr << "agsDriverExtensionsDX11_NotifyResourceEndWrites: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context)
+    return AGS_INVALID_ARGS;
+  
+  // Nothing to transfer on a single GPU
+  context->afrStats.notifyEndWrites.fetch_add(1, std::memory_order_relaxed);
+  dxvkCountCall(context, AGSTelemetryCallNotifyResource);
+  return AGS_SUCCESS;
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_NotifyResourceBeginAllAccess(
         AGSContext*                   context,
         ID3D11Resource*               resource) {
-  std::cerr << "agsDriverExtensionsDX11_NotifyResourceBeginAllAccess: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context)
+    return AGS_INVALID_ARGS;
+  
+  // Nothing to transfer on a single GPU
+  context->afrStats.notifyBeginAllAccess.fetch_add(1, std::memory_order_relaxed);
+  dxvkCountCall(context, AGSTelemetryCallNotifyResource);
+  return AGS_SUCCESS;
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX11_NotifyResourceEndAllAccess(
         AGSContext*                   context,
         ID3D11Resource*               resource) {
-  std::cerr << "agsDriverExtensionsDX11_NotifyResourceEndAllAccess: Not implemented" << std::endl;
-  return AGS_EXTENSION_NOT_SUPPORTED;
+  if (!context)
+    return AGS_INVALID_ARGS;
+  
+  // Nothing to transfer on a single GPU
+  context->afrStats.notifyEndAllAccess.fetch_add(1, std::memory_order_relaxed);
+  dxvkCountCall(context, AGSTelemetryCallNotifyResource);
+  return AGS_SUCCESS;
 }
 
 }
\ No newline at end of file
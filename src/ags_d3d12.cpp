@@ -1,4 +1,434 @@
+#include <algorithm>
+#include <cstring>
+
+#include <d3d12.h>
+
 #include "ags_private.h"
+#include "ags_profile.h"
+
+// Event metadata that PIX and vkd3d use for plain
+// char strings, which saves us a UTF-16 conversion
+constexpr UINT AGSEventMetadataAnsi = 1;
+
+static bool vkd3dIsCaptureToolLoaded() {
+  static const std::array<const char*, 2> modules = {{
+    "renderdoc.dll",
+    "WinPixGpuCapturer.dll",
+  }};
+  
+  for (auto name : modules) {
+    if (GetModuleHandleA(name))
+      return true;
+  }
+  
+  return false;
+}
+
+
+static bool vkd3dIsCaptureActive(
+        ID3D12Device*                 device) {
+  // Tools usually attach to vkd3d-proton as Vulkan
+  // layers, which only vkd3d-proton itself can see
+  ID3D12VkExtDevice1* vkd3dDevice = nullptr;
+  
+  if (SUCCEEDED(device->QueryInterface(IID_PPV_ARGS(&vkd3dDevice)))) {
+    bool active = vkd3dDevice->GetDebugUtilsConsumerActive();
+    vkd3dDevice->Release();
+    return active;
+  }
+  
+  // Older builds cannot tell, so only detect
+  // tools that inject their own library
+  return vkd3dIsCaptureToolLoaded();
+}
+
+
+static AGSShaderHash vkd3dHashShader(
+  const void*                         pShaderBytecode,
+        SIZE_T                        BytecodeLength) {
+  auto bytes = reinterpret_cast<const uint8_t*>(pShaderBytecode);
+  
+  AGSShaderHash hash = { 0ull, 0ull, BytecodeLength, 0xcbf29ce484222325ull };
+  
+  if (BytecodeLength >= 20) {
+    std::memcpy(&hash.lo, bytes + 4,  sizeof(hash.lo));
+    std::memcpy(&hash.hi, bytes + 12, sizeof(hash.hi));
+  }
+  
+  // We cannot tell a real checksum from a placeholder that
+  // a tool wrote into an unsigned container without redoing
+  // the checksum, which costs as much as hashing the code
+  for (SIZE_T i = 0; i < BytecodeLength; i++)
+    hash.data = (hash.data ^ bytes[i]) * 0x100000001b3ull;
+  
+  return hash;
+}
+
+
+static AGSShaderIntrinsics vkd3dScanShaderIntrinsics(
+        AGSContext*                   context,
+  const void*                         pShaderBytecode,
+        SIZE_T                        BytecodeLength) {
+  AGSShaderIntrinsics result = { };
+  
+  if (dxbcIsDxil(pShaderBytecode, BytecodeLength)) {
+    result.used = dxilHasIntrinsicUav(pShaderBytecode, BytecodeLength,
+      AGS_DX12_SHADER_INSTRINSICS_SPACE_ID, context->d3d12IntrinsicUavSlot);
+    return result;
+  }
+  
+  std::vector<DxbcIntrinsic> intrinsics;
+  
+  if (!dxbcScanIntrinsics(pShaderBytecode, BytecodeLength,
+      AGS_DX12_SHADER_INSTRINSICS_SPACE_ID, context->d3d12IntrinsicUavSlot, intrinsics, nullptr))
+    return result;
+  
+  // Only report intrinsics that we advertise, anything
+  // else remains a regular atomic on the dummy UAV
+  for (const auto& intrinsic : intrinsics) {
+    if (intrinsic.opcode >= 64 || !(context->d3d12IntrinsicOpcodes & (1ull << intrinsic.opcode)))
+      continue;
+    
+    D3D12_VK_SHADER_INTRINSIC_INSTRUCTION dst;
+    dst.InstructionOffset = intrinsic.offset;
+    dst.Intrinsic         = D3D12_VK_SHADER_INTRINSIC(intrinsic.opcode);
+    dst.Phase             = intrinsic.phase;
+    dst.Data              = intrinsic.data;
+    result.instructions.push_back(dst);
+  }
+  
+  result.used = !result.instructions.empty();
+  return result;
+}
+
+
+static BOOL STDMETHODCALLTYPE vkd3dQueryShaderIntrinsics(
+        void*                         pUserData,
+  const void*                         pShaderBytecode,
+        SIZE_T                        BytecodeLength,
+        D3D12_VK_SHADER_INTRINSIC_INFO* pInfo) {
+  auto context = reinterpret_cast<AGSContext*>(pUserData);
+  
+  // Games tend to create the same shaders over and over
+  // again for different pipelines, so only scan once.
+  // Map nodes are stable, so instruction arrays are
+  // valid for as long as the cache is alive.
+  AGSShaderHash hash = vkd3dHashShader(pShaderBytecode, BytecodeLength);
+  
+  std::unique_lock<std::mutex> lock(context->d3d12IntrinsicMutex);
+  auto entry = context->d3d12ShaderIntrinsics.find(hash);
+  
+  if (entry == context->d3d12ShaderIntrinsics.end()) {
+    lock.unlock();
+    AGSShaderIntrinsics intrinsics = vkd3dScanShaderIntrinsics(
+      context, pShaderBytecode, BytecodeLength);
+    lock.lock();
+    
+    entry = context->d3d12ShaderIntrinsics.emplace(hash, std::move(intrinsics)).first;
+  }
+  
+  if (!entry->second.used)
+    return FALSE;
+  
+  pInfo->IntrinsicMask    = context->d3d12IntrinsicOpcodes;
+  pInfo->InstructionCount = UINT(entry->second.instructions.size());
+  pInfo->pInstructions    = entry->second.instructions.data();
+  return TRUE;
+}
+
+
+static void vkd3dInitShaderIntrinsics(
+        AGSContext*                   context) {
+  // Profiles disable intrinsics through the D3D11 extension
+  // bits, and extensions that cover multiple intrinsics are
+  // only reported if all of the intrinsics are supported
+  struct IntrinsicInfo {
+    D3D12_VK_SHADER_INTRINSIC intrinsic;
+    unsigned int              dx12Extension;
+    unsigned int              dx11Extension;
+  };
+  
+  static const std::vector<IntrinsicInfo> intrinsicInfos = {{
+    { D3D12_VK_SHADER_INTRINSIC_READFIRSTLANE,  AGS_DX12_EXTENSION_INTRINSIC_READFIRSTLANE, AGS_DX11_EXTENSION_INTRINSIC_READFIRSTLANE },
+    { D3D12_VK_SHADER_INTRINSIC_READLANE,       AGS_DX12_EXTENSION_INTRINSIC_READLANE,      AGS_DX11_EXTENSION_INTRINSIC_READLANE },
+    { D3D12_VK_SHADER_INTRINSIC_LANEID,         AGS_DX12_EXTENSION_INTRINSIC_LANEID,        AGS_DX11_EXTENSION_INTRINSIC_LANEID },
+    { D3D12_VK_SHADER_INTRINSIC_SWIZZLE,        AGS_DX12_EXTENSION_INTRINSIC_SWIZZLE,       AGS_DX11_EXTENSION_INTRINSIC_SWIZZLE },
+    { D3D12_VK_SHADER_INTRINSIC_BALLOT,         AGS_DX12_EXTENSION_INTRINSIC_BALLOT,        AGS_DX11_EXTENSION_INTRINSIC_BALLOT },
+    { D3D12_VK_SHADER_INTRINSIC_MBCNT,          AGS_DX12_EXTENSION_INTRINSIC_MBCOUNT,       AGS_DX11_EXTENSION_INTRINSIC_MBCOUNT },
+    { D3D12_VK_SHADER_INTRINSIC_MIN3U,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_MIN3F,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_MED3U,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_MED3F,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_MAX3U,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_MAX3F,          AGS_DX12_EXTENSION_INTRINSIC_MED3,          AGS_DX11_EXTENSION_INTRINSIC_MED3 },
+    { D3D12_VK_SHADER_INTRINSIC_BARYCOORD,      AGS_DX12_EXTENSION_INTRINSIC_BARYCENTRICS,  AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS },
+    { D3D12_VK_SHADER_INTRINSIC_VTXPARAM,       AGS_DX12_EXTENSION_INTRINSIC_BARYCENTRICS,  AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS },
+    #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+    { D3D12_VK_SHADER_INTRINSIC_WAVE_REDUCE,    AGS_DX12_EXTENSION_INTRINSIC_WAVE_REDUCE,   AGS_DX11_EXTENSION_INTRINSIC_WAVE_REDUCE },
+    { D3D12_VK_SHADER_INTRINSIC_WAVE_SCAN,      AGS_DX12_EXTENSION_INTRINSIC_WAVE_SCAN,     AGS_DX11_EXTENSION_INTRINSIC_WAVE_SCAN },
+    #endif
+  }};
+  
+  context->d3d12IntrinsicExtensions = 0;
+  context->d3d12IntrinsicOpcodes    = 0;
+  context->d3d12ShaderIntrinsics.clear();
+  
+  if (!context->vkd3dDevice
+   || !context->vkd3dDevice->GetExtensionSupport(D3D12_VK_EXT_SHADER_INTRINSICS))
+    return;
+  
+  unsigned int unsupported = 0;
+  
+  for (const auto& info : intrinsicInfos) {
+    if (context->vkd3dDevice->GetShaderIntrinsicSupport(info.intrinsic)
+     && (context->extensionMask & info.dx11Extension))
+      context->d3d12IntrinsicExtensions |= info.dx12Extension;
+    else
+      unsupported |= info.dx12Extension;
+  }
+  
+  context->d3d12IntrinsicExtensions &= ~unsupported;
+  
+  for (const auto& info : intrinsicInfos) {
+    if (context->d3d12IntrinsicExtensions & info.dx12Extension)
+      context->d3d12IntrinsicOpcodes |= 1ull << info.intrinsic;
+  }
+  
+  if (!context->d3d12IntrinsicOpcodes)
+    return;
+  
+  context->vkd3dDevice->SetShaderIntrinsicHook(
+    AGS_DX12_SHADER_INSTRINSICS_SPACE_ID,
+    context->d3d12IntrinsicUavSlot,
+    &vkd3dQueryShaderIntrinsics,
+    context);
+}
+
+
+static unsigned int vkd3dGetExtensionSupport(
+        AGSContext*                   context) {
+  // User markers are always safe to report, since they
+  // have no observable effect if nobody captures them
+  unsigned int extensions = context->d3d12IntrinsicExtensions;
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+  extensions |= AGS_DX12_EXTENSION_USER_MARKERS;
+  #endif
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 2, 0)
+  if (context->d3d12AppRegistered)
+    extensions |= AGS_DX12_EXTENSION_APP_REGISTRATION;
+  #endif
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 4, 0)
+  if (context->d3d12IntrinsicExtensions)
+    extensions |= AGS_DX12_EXTENSION_INTRINSIC_UAV_BIND_SLOT;
+  #endif
+  
+  return extensions;
+}
+
+
+static void vkd3dResetDeviceState(
+        AGSContext*                   context) {
+  if (context->vkd3dDevice) {
+    if (context->d3d12IntrinsicOpcodes)
+      context->vkd3dDevice->SetShaderIntrinsicHook(0, 0, nullptr, nullptr);
+    
+    agsLog() << "D3D12 shaders with intrinsics: " << std::count_if(
+      context->d3d12ShaderIntrinsics.begin(), context->d3d12ShaderIntrinsics.end(),
+      [] (const std::pair<const AGSShaderHash, AGSShaderIntrinsics>& entry) { return entry.second.used; })
+      << " of " << context->d3d12ShaderIntrinsics.size() << " scanned";
+    
+    context->vkd3dDevice->Release();
+    context->vkd3dDevice = nullptr;
+  }
+  
+  context->d3d12IntrinsicExtensions = 0;
+  context->d3d12IntrinsicOpcodes    = 0;
+  context->d3d12ShaderIntrinsics.clear();
+  context->d3d12AppRegistered = false;
+  context->d3d12Device = nullptr;
+}
+
+
+static AGSReturnCode vkd3dTrackDevice(
+        AGSContext*                   context,
+        ID3D12Device*                 device,
+        unsigned int*                 extensionsSupported) {
+  context->d3d12Device = device;
+  
+  // Intrinsics are only available on vkd3d builds
+  // that implement our extension interface
+  if (FAILED(device->QueryInterface(IID_PPV_ARGS(&context->vkd3dDevice))))
+    context->vkd3dDevice = nullptr;
+  
+  vkd3dInitShaderIntrinsics(context);
+  
+  // Capture tools are injected before the device is
+  // created, so we only need to check for them once
+  context->userMarkersEnabled = context->userMarkerMode >= 0
+    ? context->userMarkerMode > 0
+    : vkd3dIsCaptureActive(device);
+  
+  if (context->userMarkersEnabled)
+    agsLog() << "AGS: Enabling D3D12 user markers";
+  
+  if (extensionsSupported)
+    *extensionsSupported = vkd3dGetExtensionSupport(context);
+  
+  return AGS_SUCCESS;
+}
+
+
+#if BUILD_VERSION >= AGS_MAKE_VERSION(5, 2, 0)
+static PFN_D3D12_CREATE_DEVICE vkd3dGetCreateDeviceProc(
+        AGSContext*                   context) {
+  // Games that only use D3D11 should not pull in
+  // d3d12.dll, so only load it when it is needed
+  if (!context->d3d12Module)
+    context->d3d12Module = LoadLibraryA("d3d12.dll");
+  
+  if (!context->d3d12Module)
+    return nullptr;
+  
+  return reinterpret_cast<PFN_D3D12_CREATE_DEVICE>(
+    GetProcAddress(context->d3d12Module, "D3D12CreateDevice"));
+}
+
+
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+static void vkd3dConvertExtensions(
+        unsigned int                  extensions,
+        AGSDX12ReturnedParams::ExtensionsSupported* result) {
+  auto hasAll = [extensions] (unsigned int mask) {
+    return (extensions & mask) == mask;
+  };
+  
+  *result = AGSDX12ReturnedParams::ExtensionsSupported();
+  result->intrinsics16      = hasAll(AGS_DX12_EXTENSION_INTRINSIC_READFIRSTLANE
+                                   | AGS_DX12_EXTENSION_INTRINSIC_READLANE
+                                   | AGS_DX12_EXTENSION_INTRINSIC_LANEID
+                                   | AGS_DX12_EXTENSION_INTRINSIC_SWIZZLE
+                                   | AGS_DX12_EXTENSION_INTRINSIC_BALLOT
+                                   | AGS_DX12_EXTENSION_INTRINSIC_MBCOUNT
+                                   | AGS_DX12_EXTENSION_INTRINSIC_MED3
+                                   | AGS_DX12_EXTENSION_INTRINSIC_BARYCENTRICS);
+  result->intrinsics17      = hasAll(AGS_DX12_EXTENSION_INTRINSIC_WAVE_REDUCE
+                                   | AGS_DX12_EXTENSION_INTRINSIC_WAVE_SCAN);
+  result->userMarkers       = hasAll(AGS_DX12_EXTENSION_USER_MARKERS);
+  result->appRegistration   = hasAll(AGS_DX12_EXTENSION_APP_REGISTRATION);
+  result->UAVBindSlot       = hasAll(AGS_DX12_EXTENSION_INTRINSIC_UAV_BIND_SLOT);
+}
+#endif
+
+
+static bool vkd3dRegisterApplication(
+        AGSContext*                   context,
+  const AGSDX12ExtensionParams*       extensionParams) {
+  // Only vkd3d-proton builds that know about AGS export this
+  auto pfnRegister = reinterpret_cast<PFN_VKD3D_REGISTER_APPLICATION>(
+    GetProcAddress(context->d3d12Module, "VKD3DRegisterApplication"));
+  
+  if (!pfnRegister)
+    return false;
+  
+  D3D12_VK_APPLICATION_INFO info = { };
+  
+  if (extensionParams) {
+    info.pApplicationName   = extensionParams->pAppName;
+    info.ApplicationVersion = extensionParams->appVersion;
+    info.pEngineName        = extensionParams->pEngineName;
+    info.EngineVersion      = extensionParams->engineVersion;
+  }
+  
+  return SUCCEEDED(pfnRegister(&info));
+}
+
+
+static AGSReturnCode vkd3dCreateDevice(
+        AGSContext*                   context,
+  const AGSDX12DeviceCreationParams*  creationParams,
+  const AGSDX12ExtensionParams*       extensionParams,
+        AGSDX12ReturnedParams*        returnedParams) {
+  if (!context || context->d3d12Device || !creationParams || !returnedParams)
+    return AGS_INVALID_ARGS;
+  
+  *returnedParams = AGSDX12ReturnedParams();
+  
+  // Before AGS 5.4, shaders always use u0 in the reserved space
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 4, 0)
+  context->d3d12IntrinsicUavSlot = extensionParams ? extensionParams->uavSlot : 0;
+  #else
+  context->d3d12IntrinsicUavSlot = 0;
+  #endif
+  
+  if (extensionParams)
+    agsProfileApply(context, extensionParams->pAppName, extensionParams->pEngineName);
+  
+  PFN_D3D12_CREATE_DEVICE pfnCreateDevice = vkd3dGetCreateDeviceProc(context);
+  
+  if (!pfnCreateDevice) {
+    agsLog() << "agsDriverExtensionsDX12_CreateDevice: Failed to load d3d12.dll";
+    return AGS_FAILURE;
+  }
+  
+  bool appRegistered = (context->extensionMask & AGS_DX11_EXTENSION_APP_REGISTRATION)
+    && vkd3dRegisterApplication(context, extensionParams);
+  
+  // The app may request a newer device interface, which
+  // is still a valid ID3D12Device pointer for our purposes
+  void* device = nullptr;
+  
+  HRESULT hr = pfnCreateDevice(
+    creationParams->pAdapter,
+    creationParams->FeatureLevel,
+    creationParams->iid,
+    &device);
+  
+  if (FAILED(hr))
+    return AGS_FAILURE;
+  
+  returnedParams->pDevice = reinterpret_cast<ID3D12Device*>(device);
+  
+  context->d3d12AppRegistered = appRegistered;
+  
+  #if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+  unsigned int extensions = 0;
+  AGSReturnCode ar = vkd3dTrackDevice(context,
+    returnedParams->pDevice, &extensions);
+  vkd3dConvertExtensions(extensions, &returnedParams->extensionsSupported);
+  #else
+  AGSReturnCode ar = vkd3dTrackDevice(context,
+    returnedParams->pDevice,
+    &returnedParams->extensionsSupported);
+  #endif
+  
+  agsLog() << "agsDriverExtensionsDX12_CreateDevice() = AGS_SUCCESS";
+  return ar;
+}
+
+
+static AGSReturnCode vkd3dDestroyDevice(
+        AGSContext*                   context,
+        ID3D12Device*                 device,
+        unsigned int*                 deviceReferences) {
+  if (!context || !device || device != context->d3d12Device)
+    return AGS_INVALID_ARGS;
+  
+  vkd3dResetDeviceState(context);
+  
+  // This releases the reference that CreateDevice
+  // returned to the app, same as the AMD driver
+  unsigned int refCount = device->Release();
+  
+  if (deviceReferences)
+    *deviceReferences = refCount;
+  
+  return AGS_SUCCESS;
+}
+#endif
+
 
 extern "C" {
 
@@ -8,8 +438,10 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX12_CreateDevice(
   const AGSDX12DeviceCreationParams*  creationParams,
   const AGSDX12ExtensionParams*       extensionParams,
         AGSDX12ReturnedParams*        returnedParams) {
-  std::cerr << "agsDriverExtensionsDX12_CreateDevice: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  return vkd3dCreateDevice(context,
+    creationParams,
+    extensionParams,
+    returnedParams);
 }
 
 
@@ -17,23 +449,32 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX12_DestroyDevice(
         AGSContext*                   context,
         ID3D12Device*                 device,
         unsigned int*                 deviceReferences) {
-  std::cerr << "agsDriverExtensionsDX12_DestroyDevice: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  return vkd3dDestroyDevice(context,
+    device, deviceReferences);
 }
 #else
 AMD_AGS_API AGSReturnCode agsDriverExtensionsDX12_Init(
         AGSContext*                   context,
         ID3D12Device*                 device,
         unsigned int*                 extensionsSupported) {
-  std::cerr << "agsDriverExtensionsDX12_Init: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  if (!context || !device || context->d3d12Device)
+    return AGS_INVALID_ARGS;
+  
+  context->d3d12IntrinsicUavSlot = 0;
+  
+  return vkd3dTrackDevice(context,
+    device, extensionsSupported);
 }
 
 
 AMD_AGS_API AGSReturnCode agsDriverExtensionsDX12_DeInit(
         AGSContext*                   context) {
-  std::cerr << "agsDriverExtensionsDX12_DeInit: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  if (!context || !context->d3d12Device)
+    return AGS_INVALID_ARGS;
+  
+  // The app owns the device in this version of the API
+  vkd3dResetDeviceState(context);
+  return AGS_SUCCESS;
 }
 #endif
 
@@ -43,16 +484,28 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX12_PushMarker(
         AGSContext*                   context,
         ID3D12GraphicsCommandList*    commandList,
   const char*                         data) {
-  std::cerr << "agsDriverExtensionsDX12_PushMarker: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  if (!context || !commandList || !data)
+    return AGS_INVALID_ARGS;
+  
+  // The command list copies the string, so the
+  // app's string can be passed through as-is
+  if (context->userMarkersEnabled)
+    commandList->BeginEvent(AGSEventMetadataAnsi, data, UINT(std::strlen(data) + 1));
+  
+  return AGS_SUCCESS;
 }
 
 
 AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX12_PopMarker(
         AGSContext*                   context,
         ID3D12GraphicsCommandList*    commandList) {
-  std::cerr << "agsDriverExtensionsDX12_PopMarker: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  if (!context || !commandList)
+    return AGS_INVALID_ARGS;
+  
+  if (context->userMarkersEnabled)
+    commandList->EndEvent();
+  
+  return AGS_SUCCESS;
 }
 
 
@@ -60,8 +513,13 @@ AMD_AGS_API AGSReturnCode __stdcall agsDriverExtensionsDX12_SetMarker(
         AGSContext*                   context,
         ID3D12GraphicsCommandList*    commandList,
   const char*                         data) {
-  std::cerr << "agsDriverExtensionsDX12_SetMarker: Not implemented" << std::endl;
-  return AGS_ERROR_LEGACY_DRIVER;
+  if (!context || !commandList || !data)
+    return AGS_INVALID_ARGS;
+  
+  if (context->userMarkersEnabled)
+    commandList->SetMarker(AGSEventMetadataAnsi, data, UINT(std::strlen(data) + 1));
+  
+  return AGS_SUCCESS;
 }
 #endif
 
@@ -0,0 +1,319 @@
+#include <algorithm>
+
+#include "ags_drawcount.h"
+
+// Number of frames that may be in flight before we
+// stop adapting draw counts instead of waiting
+constexpr uint32_t AGSDrawCountMaxFrames  = 8;
+constexpr uint32_t AGSDrawCountMaxSamples = 1024;
+
+// Number of counts that need to be read back for a
+// call site before its draw count gets clamped
+constexpr uint32_t AGSDrawCountMinSamples = 16;
+constexpr uint32_t AGSDrawCountMinHeadroom = 64;
+
+// Number of frames after which call sites that
+// were not used anymore are forgotten
+constexpr uint32_t AGSDrawCountSiteMaxAge = 256;
+
+// Private data of count buffers, storing a unique ID so
+// that a new buffer at the address of a destroyed one
+// does not inherit the clamped count of the old one
+static const GUID agsDrawCountBufferGuid = { 0x1c4f7e2a, 0x8b63, 0x4d95, { 0xb2, 0x0e, 0x57, 0xa9, 0x3d, 0xc6, 0x14, 0x82 } };
+
+static std::atomic<uint64_t> agsDrawCountNextBufferId = { 0ull };
+
+struct AGSDrawCountKey {
+  uint64_t          bufferId;
+  uint32_t          offset;
+  
+  bool operator == (const AGSDrawCountKey& other) const {
+    return bufferId == other.bufferId && offset == other.offset;
+  }
+};
+
+struct AGSDrawCountKeyHash {
+  size_t operator () (const AGSDrawCountKey& key) const {
+    size_t hash = std::hash<uint64_t>()(key.bufferId);
+    hash ^= size_t(key.offset) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+struct AGSDrawCountSite {
+  uint32_t highWater;
+  uint32_t samples;
+  bool     overflowed;
+  uint64_t lastFrame;
+};
+
+struct AGSDrawCountSample {
+  AGSDrawCountKey   key;
+  uint32_t          maxDrawCount;
+  bool              clamped;
+};
+
+struct AGSDrawCountFrame {
+  ID3D11Buffer*                   staging;
+  ID3D11Query*                    event;
+  std::vector<AGSDrawCountSample> samples;
+};
+
+struct AGSDrawCountTracker {
+  ID3D11Device*         device;
+  ID3D11DeviceContext*  context;
+  
+  // Frames that have ended but are not resolved yet,
+  // followed by the frame currently being recorded.
+  // Staging buffers hold one draw count per sample.
+  std::array<AGSDrawCountFrame, AGSDrawCountMaxFrames + 1> frames;
+  uint32_t              frameHead;
+  uint32_t              frameCount;
+  uint64_t              frameId;
+  
+  uint64_t              clampedCalls;
+  uint64_t              droppedSamples;
+  uint64_t              overflows;
+  uint64_t              evictedSites;
+  
+  std::unordered_map<AGSDrawCountKey, AGSDrawCountSite, AGSDrawCountKeyHash> sites;
+};
+
+
+static AGSDrawCountFrame& agsGetCurrentFrame(
+        AGSDrawCountTracker*          tracker) {
+  return tracker->frames[(tracker->frameHead + tracker->frameCount) % tracker->frames.size()];
+}
+
+
+static uint64_t agsGetBufferId(
+        ID3D11Buffer*                 buffer) {
+  uint64_t id = 0;
+  UINT size = sizeof(id);
+  
+  if (SUCCEEDED(buffer->GetPrivateData(agsDrawCountBufferGuid, &size, &id)) && size == sizeof(id))
+    return id;
+  
+  id = agsDrawCountNextBufferId.fetch_add(1, std::memory_order_relaxed) + 1;
+  buffer->SetPrivateData(agsDrawCountBufferGuid, sizeof(id), &id);
+  return id;
+}
+
+
+static void agsEvictSites(
+        AGSDrawCountTracker*          tracker) {
+  for (auto i = tracker->sites.begin(); i != tracker->sites.end(); ) {
+    if (i->second.lastFrame + AGSDrawCountSiteMaxAge < tracker->frameId) {
+      i = tracker->sites.erase(i);
+      tracker->evictedSites += 1;
+    } else {
+      i++;
+    }
+  }
+}
+
+
+static bool agsInitFrame(
+        AGSDrawCountTracker*          tracker,
+        AGSDrawCountFrame&            frame) {
+  if (!frame.staging) {
+    D3D11_BUFFER_DESC desc = { };
+    desc.ByteWidth      = AGSDrawCountMaxSamples * sizeof(uint32_t);
+    desc.Usage          = D3D11_USAGE_STAGING;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    
+    if (FAILED(tracker->device->CreateBuffer(&desc, nullptr, &frame.staging)))
+      return false;
+  }
+  
+  if (!frame.event) {
+    D3D11_QUERY_DESC desc = { D3D11_QUERY_EVENT, 0 };
+    
+    if (FAILED(tracker->device->CreateQuery(&desc, &frame.event)))
+      return false;
+  }
+  
+  return true;
+}
+
+
+static bool agsResolveFrame(
+        AGSDrawCountTracker*          tracker,
+        AGSDrawCountFrame&            frame) {
+  if (tracker->context->GetData(frame.event, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+    return false;
+  
+  D3D11_MAPPED_SUBRESOURCE mapped;
+  
+  if (FAILED(tracker->context->Map(frame.staging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped)))
+    return false;
+  
+  auto counts = reinterpret_cast<const uint32_t*>(mapped.pData);
+  
+  for (size_t i = 0; i < frame.samples.size(); i++) {
+    const AGSDrawCountSample& sample = frame.samples[i];
+    AGSDrawCountSite& site = tracker->sites[sample.key];
+    
+    // A count above a clamped bound means that draws
+    // got dropped, so stop clamping this site for good
+    if (sample.clamped && counts[i] > sample.maxDrawCount && !site.overflowed) {
+      site.overflowed = true;
+      tracker->overflows += 1;
+    }
+    
+    site.highWater  = std::max(site.highWater, counts[i]);
+    site.samples   += 1;
+    site.lastFrame  = std::max(site.lastFrame, tracker->frameId);
+  }
+  
+  tracker->context->Unmap(frame.staging, 0);
+  
+  frame.samples.clear();
+  return true;
+}
+
+
+static unsigned int agsGetAdaptedDrawCount(
+  const AGSDrawCountSite&             site,
+        unsigned int                  maxDrawCount) {
+  if (site.overflowed || site.samples < AGSDrawCountMinSamples)
+    return maxDrawCount;
+  
+  uint64_t headroom = std::max(site.highWater / 2, AGSDrawCountMinHeadroom);
+  uint64_t bound    = (uint64_t(site.highWater) + headroom + AGSDrawCountMinHeadroom - 1)
+                    & ~uint64_t(AGSDrawCountMinHeadroom - 1);
+  
+  return unsigned(std::min(bound, uint64_t(maxDrawCount)));
+}
+
+
+void agsDrawCountInit(
+        AGSContext*                   context) {
+  context->drawCountTracker = nullptr;
+  
+  if (!context->adaptiveDrawCountEnabled)
+    return;
+  
+  auto tracker = new AGSDrawCountTracker();
+  context->dxvkDevice->QueryInterface(IID_PPV_ARGS(&tracker->device));
+  context->dxvkContext->QueryInterface(IID_PPV_ARGS(&tracker->context));
+  
+  tracker->frameHead      = 0;
+  tracker->frameCount     = 0;
+  tracker->frameId        = 0;
+  tracker->clampedCalls   = 0;
+  tracker->droppedSamples = 0;
+  tracker->overflows      = 0;
+  tracker->evictedSites   = 0;
+  
+  for (auto& frame : tracker->frames) {
+    frame.staging = nullptr;
+    frame.event   = nullptr;
+    frame.samples.reserve(AGSDrawCountMaxSamples);
+  }
+  
+  context->drawCountTracker = tracker;
+}
+
+
+void agsDrawCountDestroy(
+        AGSContext*                   context) {
+  AGSDrawCountTracker* tracker = context->drawCountTracker;
+  
+  if (!tracker)
+    return;
+  
+  agsLog() << "AGS adaptive draw count: " << tracker->sites.size() << " call sites, "
+           << tracker->evictedSites << " evicted, "
+           << tracker->clampedCalls << " calls clamped, "
+           << tracker->overflows << " sites overflowed, "
+           << tracker->droppedSamples << " samples dropped";
+  
+  for (auto& frame : tracker->frames) {
+    if (frame.staging)
+      frame.staging->Release();
+    
+    if (frame.event)
+      frame.event->Release();
+  }
+  
+  tracker->context->Release();
+  tracker->device->Release();
+  
+  delete tracker;
+  context->drawCountTracker = nullptr;
+}
+
+
+void agsDrawCountEndFrame(
+        AGSContext*                   context) {
+  AGSDrawCountTracker* tracker = context->drawCountTracker;
+  
+  if (!tracker)
+    return;
+  
+  AGSDrawCountFrame& current = agsGetCurrentFrame(tracker);
+  
+  if (!current.samples.empty()) {
+    tracker->context->End(current.event);
+    tracker->frameCount += 1;
+  }
+  
+  while (tracker->frameCount) {
+    if (!agsResolveFrame(tracker, tracker->frames[tracker->frameHead]))
+      break;
+    
+    tracker->frameHead = (tracker->frameHead + 1) % tracker->frames.size();
+    tracker->frameCount -= 1;
+  }
+  
+  tracker->frameId += 1;
+  
+  if (!(tracker->frameId % AGSDrawCountSiteMaxAge))
+    agsEvictSites(tracker);
+}
+
+
+unsigned int agsDrawCountAdaptSample(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        ID3D11Buffer*                 countBuffer,
+        uint32_t                      countOffset,
+        unsigned int                  maxDrawCount) {
+  AGSDrawCountTracker* tracker = context->drawCountTracker;
+  
+  if (dxvkContext != context->dxvkContext)
+    return maxDrawCount;
+  
+  // Only clamp calls whose draw count gets read back,
+  // so that every clamped call is checked for overflow
+  AGSDrawCountFrame& frame = agsGetCurrentFrame(tracker);
+  
+  if (tracker->frameCount == AGSDrawCountMaxFrames
+   || frame.samples.size() == AGSDrawCountMaxSamples
+   || !agsInitFrame(tracker, frame)) {
+    tracker->droppedSamples += 1;
+    return maxDrawCount;
+  }
+  
+  AGSDrawCountSample sample;
+  sample.key          = { agsGetBufferId(countBuffer), countOffset };
+  
+  AGSDrawCountSite& site = tracker->sites[sample.key];
+  site.lastFrame = tracker->frameId;
+  
+  sample.maxDrawCount = agsGetAdaptedDrawCount(site, maxDrawCount);
+  sample.clamped      = sample.maxDrawCount < maxDrawCount;
+  
+  D3D11_BOX box = { countOffset, 0, 0, countOffset + uint32_t(sizeof(uint32_t)), 1, 1 };
+  
+  tracker->context->CopySubresourceRegion(frame.staging, 0,
+    uint32_t(frame.samples.size() * sizeof(uint32_t)), 0, 0,
+    countBuffer, 0, &box);
+  
+  if (sample.clamped)
+    tracker->clampedCalls += 1;
+  
+  frame.samples.push_back(sample);
+  return sample.maxDrawCount;
+}
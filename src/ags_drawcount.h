@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ags_private.h"
+
+struct AGSDrawCountTracker;
+
+/**
+ * \brief Initializes draw count tracking
+ * 
+ * Does nothing unless adaptive draw counts are enabled.
+ * \param [in] context The AGS context
+ */
+void agsDrawCountInit(
+        AGSContext*                   context);
+
+/**
+ * \brief Destroys draw count tracking state
+ * 
+ * Logs how many call sites were clamped
+ * and how many of them overflowed.
+ * \param [in] context The AGS context
+ */
+void agsDrawCountDestroy(
+        AGSContext*                   context);
+
+/**
+ * \brief Ends draw count tracking for the current frame
+ * 
+ * Reads back draw counts of previous frames that
+ * are available without flushing, and never waits.
+ * \param [in] context The AGS context
+ */
+void agsDrawCountEndFrame(
+        AGSContext*                   context);
+
+/**
+ * \brief Adapts the maximum draw count of a call
+ * 
+ * Records a copy of the draw count for read-back, and
+ * clamps the maximum draw count to the highest count
+ * observed for the count buffer and offset plus some
+ * headroom. Call sites that ever exceeded the clamped
+ * count use the full bound from then on, and sites that
+ * are not used for a while are forgotten. Only calls on
+ * the immediate context are adapted, since we cannot
+ * read back data written by deferred contexts in order.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context the call is recorded into
+ * \param [in] countBuffer Draw count buffer
+ * \param [in] countOffset Offset of the draw count
+ * \param [in] maxDrawCount Full bound for the draw count
+ * \returns Maximum draw count to pass to the call
+ */
+unsigned int agsDrawCountAdaptSample(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        ID3D11Buffer*                 countBuffer,
+        uint32_t                      countOffset,
+        unsigned int                  maxDrawCount);
+
+
+inline unsigned int agsDrawCountAdapt(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        ID3D11Buffer*                 countBuffer,
+        uint32_t                      countOffset,
+        unsigned int                  maxDrawCount) {
+  return context->drawCountTracker
+    ? agsDrawCountAdaptSample(context, dxvkContext, countBuffer, countOffset, maxDrawCount)
+    : maxDrawCount;
+}
@@ -0,0 +1,292 @@
+#include <algorithm>
+
+#include "ags_emulation.h"
+
+// Size of the scratch argument buffer. Count draws are
+// processed in chunks of as many draws as fit into it.
+constexpr uint32_t AGSEmulationScratchSize = 65536;
+
+// Zeroes the instance count of draws past the draw count.
+// Both indirect argument structures store the instance
+// count at byte offset 4, so one shader covers both.
+//
+// cs_5_0
+// dcl_globalFlags refactoringAllowed
+// dcl_constantbuffer CB0[1], immediateIndexed
+// dcl_resource_raw t0
+// dcl_uav_raw u0
+// dcl_input vThreadID.x
+// dcl_temps 1
+// dcl_thread_group 64, 1, 1
+// uge r0.x, vThreadID.x, cb0[0].z
+// if_nz r0.x
+//   ret
+// endif
+// ld_raw r0.x, l(0), t0.xxxx
+// iadd r0.y, vThreadID.x, cb0[0].x
+// uge r0.x, r0.y, r0.x
+// if_nz r0.x
+//   imad r0.z, vThreadID.x, cb0[0].y, l(4)
+//   store_raw u0.x, r0.z, l(0)
+// endif
+// ret
+static const uint32_t agsClampDrawCountCs[] = {
+  0x43425844, 0x0755e7d8, 0x99c40bd7, 0xc717fc9f, 0x2e38f4d8, 0x00000001,
+  0x00000158, 0x00000001, 0x00000024, 0x58454853, 0x0000012c, 0x00050050,
+  0x0000004b, 0x0100086a, 0x04000059, 0x00208e46, 0x00000000, 0x00000001,
+  0x030000a1, 0x00107000, 0x00000000, 0x0300009d, 0x0011e000, 0x00000000,
+  0x0200005f, 0x00020012, 0x02000068, 0x00000001, 0x0400009b, 0x00000040,
+  0x00000001, 0x00000001, 0x07000050, 0x00100012, 0x00000000, 0x0002000a,
+  0x0020802a, 0x00000000, 0x00000000, 0x0304001f, 0x0010000a, 0x00000000,
+  0x0100003e, 0x01000015, 0x070000a5, 0x00100012, 0x00000000, 0x00004001,
+  0x00000000, 0x00107006, 0x00000000, 0x0700001e, 0x00100022, 0x00000000,
+  0x0002000a, 0x0020800a, 0x00000000, 0x00000000, 0x07000050, 0x00100012,
+  0x00000000, 0x0010001a, 0x00000000, 0x0010000a, 0x00000000, 0x0304001f,
+  0x0010000a, 0x00000000, 0x09000023, 0x00100042, 0x00000000, 0x0002000a,
+  0x0020801a, 0x00000000, 0x00000000, 0x00004001, 0x00000004, 0x070000a6,
+  0x0011e012, 0x00000000, 0x0010002a, 0x00000000, 0x00004001, 0x00000000,
+  0x01000015, 0x0100003e,
+};
+
+struct AGSEmulationConstants {
+  uint32_t firstDraw;
+  uint32_t byteStride;
+  uint32_t drawCount;
+  uint32_t reserved;
+};
+
+struct AGSEmulation {
+  bool                        valid;
+  ID3D11ComputeShader*        clampShader;
+  ID3D11Buffer*               constantBuffer;
+  ID3D11Buffer*               countBuffer;
+  ID3D11ShaderResourceView*   countView;
+  ID3D11Buffer*               argBuffer;
+  ID3D11UnorderedAccessView*  argView;
+};
+
+
+static ID3D11DeviceContext* agsGetD3D11Context(
+        ID3D11VkExtContext*           dxvkContext) {
+  ID3D11DeviceContext* ctx = nullptr;
+  dxvkContext->QueryInterface(IID_PPV_ARGS(&ctx));
+  ctx->Release();
+  return ctx;
+}
+
+
+static void agsDrawIndirect(
+        ID3D11DeviceContext*          ctx,
+        bool                          indexed,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs) {
+  if (indexed)
+    ctx->DrawIndexedInstancedIndirect(pBufferForArgs, alignedByteOffsetForArgs);
+  else
+    ctx->DrawInstancedIndirect(pBufferForArgs, alignedByteOffsetForArgs);
+}
+
+
+static bool agsCreateEmulationResources(
+        AGSEmulation*                 emulation,
+        ID3D11Device*                 device) {
+  if (FAILED(device->CreateComputeShader(agsClampDrawCountCs,
+      sizeof(agsClampDrawCountCs), nullptr, &emulation->clampShader)))
+    return false;
+  
+  D3D11_BUFFER_DESC bufferDesc = { };
+  bufferDesc.ByteWidth      = sizeof(AGSEmulationConstants);
+  bufferDesc.Usage          = D3D11_USAGE_DEFAULT;
+  bufferDesc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+  
+  if (FAILED(device->CreateBuffer(&bufferDesc, nullptr, &emulation->constantBuffer)))
+    return false;
+  
+  bufferDesc.ByteWidth      = 16;
+  bufferDesc.BindFlags      = D3D11_BIND_SHADER_RESOURCE;
+  bufferDesc.MiscFlags      = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+  
+  if (FAILED(device->CreateBuffer(&bufferDesc, nullptr, &emulation->countBuffer)))
+    return false;
+  
+  bufferDesc.ByteWidth      = AGSEmulationScratchSize;
+  bufferDesc.BindFlags      = D3D11_BIND_UNORDERED_ACCESS;
+  bufferDesc.MiscFlags      = D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS
+                            | D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+  
+  if (FAILED(device->CreateBuffer(&bufferDesc, nullptr, &emulation->argBuffer)))
+    return false;
+  
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = { };
+  srvDesc.Format                = DXGI_FORMAT_R32_TYPELESS;
+  srvDesc.ViewDimension         = D3D11_SRV_DIMENSION_BUFFEREX;
+  srvDesc.BufferEx.NumElements  = 4;
+  srvDesc.BufferEx.Flags        = D3D11_BUFFEREX_SRV_FLAG_RAW;
+  
+  if (FAILED(device->CreateShaderResourceView(emulation->countBuffer, &srvDesc, &emulation->countView)))
+    return false;
+  
+  D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = { };
+  uavDesc.Format                = DXGI_FORMAT_R32_TYPELESS;
+  uavDesc.ViewDimension         = D3D11_UAV_DIMENSION_BUFFER;
+  uavDesc.Buffer.NumElements    = AGSEmulationScratchSize / 4;
+  uavDesc.Buffer.Flags          = D3D11_BUFFER_UAV_FLAG_RAW;
+  
+  if (FAILED(device->CreateUnorderedAccessView(emulation->argBuffer, &uavDesc, &emulation->argView)))
+    return false;
+  
+  return true;
+}
+
+
+static void agsReleaseEmulationResources(
+        AGSEmulation*                 emulation) {
+  if (emulation->argView)         emulation->argView->Release();
+  if (emulation->argBuffer)       emulation->argBuffer->Release();
+  if (emulation->countView)       emulation->countView->Release();
+  if (emulation->countBuffer)     emulation->countBuffer->Release();
+  if (emulation->constantBuffer)  emulation->constantBuffer->Release();
+  if (emulation->clampShader)     emulation->clampShader->Release();
+}
+
+
+static AGSEmulation* agsGetEmulation(
+        AGSContext*                   context) {
+  std::lock_guard<std::mutex> lock(context->emulationMutex);
+  
+  // Only try to create the resources once, and
+  // fall back to the extension if that failed
+  if (!context->emulation) {
+    auto emulation = new AGSEmulation();
+    
+    ID3D11Device* device = nullptr;
+    context->dxvkDevice->QueryInterface(IID_PPV_ARGS(&device));
+    emulation->valid = agsCreateEmulationResources(emulation, device);
+    device->Release();
+    
+    if (!emulation->valid)
+      agsLog() << "AGS: Failed to create emulation resources";
+    
+    context->emulation = emulation;
+  }
+  
+  return context->emulation->valid
+    ? context->emulation
+    : nullptr;
+}
+
+
+void agsEmulationDestroy(
+        AGSContext*                   context) {
+  std::lock_guard<std::mutex> lock(context->emulationMutex);
+  
+  if (!context->emulation)
+    return;
+  
+  agsReleaseEmulationResources(context->emulation);
+  
+  delete context->emulation;
+  context->emulation = nullptr;
+}
+
+
+void agsEmulateMultiDrawIndirect(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  drawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs) {
+  ID3D11DeviceContext* ctx = agsGetD3D11Context(dxvkContext);
+  
+  for (unsigned int i = 0; i < drawCount; i++) {
+    agsDrawIndirect(ctx, indexed, pBufferForArgs,
+      alignedByteOffsetForArgs + i * byteStrideForArgs);
+  }
+}
+
+
+bool agsEmulateMultiDrawIndirectCount(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  maxDrawCount,
+        ID3D11Buffer*                 pBufferForDrawCount,
+        unsigned int                  alignedByteOffsetForDrawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs) {
+  uint32_t chunkSize = byteStrideForArgs
+    ? AGSEmulationScratchSize / byteStrideForArgs
+    : 0;
+  
+  AGSEmulation* emulation = chunkSize
+    ? agsGetEmulation(context)
+    : nullptr;
+  
+  if (!emulation)
+    return false;
+  
+  if (!maxDrawCount)
+    return true;
+  
+  ID3D11DeviceContext* ctx = agsGetD3D11Context(dxvkContext);
+  
+  D3D11_BOX countBox = { alignedByteOffsetForDrawCount, 0, 0,
+    alignedByteOffsetForDrawCount + 4, 1, 1 };
+  
+  ctx->CopySubresourceRegion(emulation->countBuffer, 0, 0, 0, 0,
+    pBufferForDrawCount, 0, &countBox);
+  
+  // Preserve the app's compute shader bindings
+  ID3D11ComputeShader*        prevShader    = nullptr;
+  ID3D11Buffer*               prevConstants = nullptr;
+  ID3D11ShaderResourceView*   prevView      = nullptr;
+  ID3D11UnorderedAccessView*  prevUav       = nullptr;
+  
+  ctx->CSGetShader(&prevShader, nullptr, nullptr);
+  ctx->CSGetConstantBuffers(0, 1, &prevConstants);
+  ctx->CSGetShaderResources(0, 1, &prevView);
+  ctx->CSGetUnorderedAccessViews(0, 1, &prevUav);
+  
+  ctx->CSSetShader(emulation->clampShader, nullptr, 0);
+  ctx->CSSetConstantBuffers(0, 1, &emulation->constantBuffer);
+  ctx->CSSetShaderResources(0, 1, &emulation->countView);
+  
+  for (uint32_t firstDraw = 0; firstDraw < maxDrawCount; firstDraw += chunkSize) {
+    uint32_t drawCount = std::min(maxDrawCount - firstDraw, chunkSize);
+    uint32_t argOffset = alignedByteOffsetForArgs + firstDraw * byteStrideForArgs;
+    
+    D3D11_BOX argBox = { argOffset, 0, 0,
+      argOffset + drawCount * byteStrideForArgs, 1, 1 };
+    
+    ctx->CopySubresourceRegion(emulation->argBuffer, 0, 0, 0, 0,
+      pBufferForArgs, 0, &argBox);
+    
+    AGSEmulationConstants constants = { firstDraw, byteStrideForArgs, drawCount, 0 };
+    ctx->UpdateSubresource(emulation->constantBuffer, 0, nullptr, &constants, 0, 0);
+    
+    ctx->CSSetUnorderedAccessViews(0, 1, &emulation->argView, nullptr);
+    ctx->Dispatch((drawCount + 63) / 64, 1, 1);
+    
+    // The scratch buffer must not be bound as
+    // a UAV while it is used for indirect draws
+    ID3D11UnorderedAccessView* nullUav = nullptr;
+    ctx->CSSetUnorderedAccessViews(0, 1, &nullUav, nullptr);
+    
+    for (uint32_t i = 0; i < drawCount; i++)
+      agsDrawIndirect(ctx, indexed, emulation->argBuffer, i * byteStrideForArgs);
+  }
+  
+  ctx->CSSetShader(prevShader, nullptr, 0);
+  ctx->CSSetConstantBuffers(0, 1, &prevConstants);
+  ctx->CSSetShaderResources(0, 1, &prevView);
+  ctx->CSSetUnorderedAccessViews(0, 1, &prevUav, nullptr);
+  
+  if (prevShader)     prevShader->Release();
+  if (prevConstants)  prevConstants->Release();
+  if (prevView)       prevView->Release();
+  if (prevUav)        prevUav->Release();
+  return true;
+}
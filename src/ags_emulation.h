@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ags_private.h"
+
+struct AGSEmulation;
+
+/**
+ * \brief Destroys emulation resources
+ * 
+ * Must be called before the device is released.
+ * \param [in] context The AGS context
+ */
+void agsEmulationDestroy(
+        AGSContext*                   context);
+
+/**
+ * \brief Emulates Multi-Draw Indirect
+ * 
+ * Issues one indirect draw per set of arguments. Used
+ * if DXVK does not support the extension, or if it
+ * has been switched off.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context to record the draws into
+ * \param [in] indexed Whether to issue indexed draws
+ * \param [in] drawCount Number of draws
+ * \param [in] pBufferForArgs Draw argument buffer
+ * \param [in] alignedByteOffsetForArgs Offset of the first draw
+ * \param [in] byteStrideForArgs Stride between draws
+ */
+void agsEmulateMultiDrawIndirect(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  drawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs);
+
+/**
+ * \brief Emulates Multi-Draw Indirect Count
+ * 
+ * Copies the draw arguments into a scratch buffer in
+ * chunks, and zeroes the instance count of all draws
+ * past the draw count with a compute shader before
+ * issuing one indirect draw per set of arguments.
+ * Compute shader state is restored afterwards. Only
+ * used if the extension has been switched off.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context to record the draws into
+ * \param [in] indexed Whether to issue indexed draws
+ * \param [in] maxDrawCount Maximum number of draws
+ * \param [in] pBufferForDrawCount Draw count buffer
+ * \param [in] alignedByteOffsetForDrawCount Offset of the draw count
+ * \param [in] pBufferForArgs Draw argument buffer
+ * \param [in] alignedByteOffsetForArgs Offset of the first draw
+ * \param [in] byteStrideForArgs Stride between draws
+ * \returns \c false if the required resources could not be created
+ */
+bool agsEmulateMultiDrawIndirectCount(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        bool                          indexed,
+        unsigned int                  maxDrawCount,
+        ID3D11Buffer*                 pBufferForDrawCount,
+        unsigned int                  alignedByteOffsetForDrawCount,
+        ID3D11Buffer*                 pBufferForArgs,
+        unsigned int                  alignedByteOffsetForArgs,
+        unsigned int                  byteStrideForArgs);
@@ -0,0 +1,2120 @@
+#include <cstring>
+
+#include "ags_interposer.h"
+#include "ags_drawcount.h"
+#include "ags_stats.h"
+#include "ags_timing.h"
+
+// Private data of draw count buffers that holds the
+// values last written by the CPU
+static const GUID agsDrawCountShadowGuid = { 0x5e0c8a37, 0x6d21, 0x4b9f, { 0x8e, 0x54, 0x1a, 0xc7, 0x93, 0x02, 0xf6, 0xbd } };
+
+// Only small buffers are shadowed, which covers
+// buffers that hold one or a few draw counts
+constexpr uint32_t AGSDrawCountShadowSize = 64;
+
+struct AGSDrawCountShadow {
+  uint32_t epoch;
+  uint32_t reserved;
+  uint64_t validMask;
+  uint32_t counts[AGSDrawCountShadowSize];
+};
+
+
+static bool agsGetDrawCountShadow(
+        AGSContext*                   context,
+        ID3D11Resource*               resource,
+        AGSDrawCountShadow*           shadow) {
+  UINT size = sizeof(*shadow);
+  
+  return SUCCEEDED(resource->GetPrivateData(agsDrawCountShadowGuid, &size, shadow))
+      && size == sizeof(*shadow)
+      && shadow->epoch == context->drawCountEpoch;
+}
+
+
+static bool agsIsDrawCountBuffer(
+        AGSContext*                   context,
+        ID3D11Resource*               resource) {
+  return context->drawCountShadowing && resource
+      && context->drawCountBuffers.find(resource) != context->drawCountBuffers.end();
+}
+
+
+
+// Hooks are plain static functions rather than virtual
+// methods so that they get inlined into the wrappers,
+// and hooks that do not do anything cost nothing.
+static void agsHookPresent(
+        AGSContext*                   context) {
+  agsStatsEndFrame(context);
+  agsTimingEndFrame(context);
+  agsDrawCountEndFrame(context);
+}
+
+
+static void agsHookDraw(
+        AGSContext*                   context) {
+
+}
+
+
+static void agsHookDispatch(
+        AGSContext*                   context) {
+
+}
+
+
+static void agsHookStateChange(
+        AGSContext*                   context,
+        uint32_t                      flags) {
+
+}
+
+
+static void agsHookBufferWrite(
+        AGSContext*                   context,
+        ID3D11Resource*               resource,
+  const D3D11_BOX*                    box,
+  const void*                         data,
+        bool                          discard) {
+  if (!agsIsDrawCountBuffer(context, resource) || !data)
+    return;
+  
+  D3D11_RESOURCE_DIMENSION dimension;
+  resource->GetType(&dimension);
+  
+  if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+    return;
+  
+  // Buffers that the GPU can write to are never shadowed,
+  // so that CPU writes are the only way to change them
+  constexpr UINT gpuWriteFlags = D3D11_BIND_UNORDERED_ACCESS
+    | D3D11_BIND_RENDER_TARGET | D3D11_BIND_STREAM_OUTPUT;
+  
+  D3D11_BUFFER_DESC desc;
+  static_cast<ID3D11Buffer*>(resource)->GetDesc(&desc);
+  
+  if ((desc.BindFlags & gpuWriteFlags)
+   || desc.ByteWidth > AGSDrawCountShadowSize * sizeof(uint32_t))
+    return;
+  
+  AGSDrawCountShadow shadow;
+  
+  if (discard || !agsGetDrawCountShadow(context, resource, &shadow))
+    shadow = AGSDrawCountShadow();
+  
+  shadow.epoch = context->drawCountEpoch;
+  
+  uint32_t begin = box ? box->left : 0;
+  uint32_t end   = box ? std::min(box->right, desc.ByteWidth) : desc.ByteWidth;
+  
+  // Counts that are only partially written are unknown
+  for (uint32_t i = begin / sizeof(uint32_t); i * sizeof(uint32_t) < end; i++) {
+    uint32_t offset = i * sizeof(uint32_t);
+    
+    if (offset >= begin && offset + sizeof(uint32_t) <= end) {
+      std::memcpy(&shadow.counts[i], reinterpret_cast<const char*>(data) + (offset - begin), sizeof(uint32_t));
+      shadow.validMask |= 1ull << i;
+    } else {
+      shadow.validMask &= ~(1ull << i);
+    }
+  }
+  
+  resource->SetPrivateData(agsDrawCountShadowGuid, sizeof(shadow), &shadow);
+}
+
+
+static void agsHookBufferInvalidate(
+        AGSContext*                   context,
+        ID3D11Resource*               resource) {
+  if (agsIsDrawCountBuffer(context, resource))
+    resource->SetPrivateData(agsDrawCountShadowGuid, 0, nullptr);
+}
+
+
+static void agsHookViewInvalidate(
+        AGSContext*                   context,
+        ID3D11View*                   view) {
+  if (!context->drawCountShadowing || !view)
+    return;
+  
+  ID3D11Resource* resource = nullptr;
+  view->GetResource(&resource);
+  
+  agsHookBufferInvalidate(context, resource);
+  resource->Release();
+}
+
+
+bool agsInterposerGetDrawCount(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        ID3D11Buffer*                 buffer,
+        uint32_t                      offset,
+        uint32_t*                     drawCount) {
+  if (!context->drawCountShadowing
+   || dxvkContext != context->dxvkContext
+   || offset % sizeof(uint32_t))
+    return false;
+  
+  // Buffers can be released without us noticing, so
+  // don't let stale pointers accumulate indefinitely.
+  // The shadow copy itself dies with the buffer.
+  if (context->drawCountBuffers.insert(buffer).second) {
+    if (context->drawCountBuffers.size() > 4096) {
+      context->drawCountBuffers.clear();
+      context->drawCountBuffers.insert(buffer);
+    }
+    
+    return false;
+  }
+  
+  AGSDrawCountShadow shadow;
+  uint32_t index = offset / sizeof(uint32_t);
+  
+  if (index >= AGSDrawCountShadowSize
+   || !agsGetDrawCountShadow(context, buffer, &shadow)
+   || !(shadow.validMask & (1ull << index)))
+    return false;
+  
+  *drawCount = shadow.counts[index];
+  return true;
+}
+
+
+AgsDeviceContext::AgsDeviceContext(
+        AGSContext*                   context,
+        ID3D11DeviceContext4*         ctx)
+: m_context(context), m_ctx(ctx) {
+  m_context->drawCountShadowing = m_context->cpuDrawCountEnabled;
+}
+
+
+AgsDeviceContext::~AgsDeviceContext() {
+  m_ctx->Release();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::QueryInterface(
+        REFIID                        riid,
+        void**                        ppvObject) {
+  if (!ppvObject)
+    return E_POINTER;
+  
+  if (riid == __uuidof(IUnknown)
+   || riid == __uuidof(ID3D11DeviceChild)
+   || riid == __uuidof(ID3D11DeviceContext)
+   || riid == __uuidof(ID3D11DeviceContext1)
+   || riid == __uuidof(ID3D11DeviceContext2)
+   || riid == __uuidof(ID3D11DeviceContext3)
+   || riid == __uuidof(ID3D11DeviceContext4)) {
+    *ppvObject = static_cast<ID3D11DeviceContext4*>(this);
+    AddRef();
+    return S_OK;
+  }
+  
+  return m_ctx->QueryInterface(riid, ppvObject);
+}
+
+
+ULONG STDMETHODCALLTYPE AgsDeviceContext::AddRef() {
+  return ++m_refCount;
+}
+
+
+ULONG STDMETHODCALLTYPE AgsDeviceContext::Release() {
+  ULONG refCount = --m_refCount;
+  
+  if (!refCount)
+    delete this;
+  
+  return refCount;
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GetDevice(
+        ID3D11Device**                ppDevice) {
+  m_ctx->GetDevice(ppDevice);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::GetPrivateData(
+        REFGUID                       guid,
+        UINT*                         pDataSize,
+        void*                         pData) {
+  return m_ctx->GetPrivateData(guid, pDataSize, pData);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::SetPrivateData(
+        REFGUID                       guid,
+        UINT                          DataSize,
+  const void*                         pData) {
+  return m_ctx->SetPrivateData(guid, DataSize, pData);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::SetPrivateDataInterface(
+        REFGUID                       guid,
+  const IUnknown*                     pData) {
+  return m_ctx->SetPrivateDataInterface(guid, pData);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->VSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->PSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSSetShader(
+        ID3D11PixelShader*            pPixelShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->PSSetShader(pPixelShader, ppClassInstances, NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->PSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSSetShader(
+        ID3D11VertexShader*           pVertexShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->VSSetShader(pVertexShader, ppClassInstances, NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawIndexed(
+        UINT                          IndexCount,
+        UINT                          StartIndexLocation,
+        INT                           BaseVertexLocation) {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Draw(
+        UINT                          VertexCount,
+        UINT                          StartVertexLocation) {
+  agsHookDraw(m_context);
+  
+  m_ctx->Draw(VertexCount, StartVertexLocation);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::Map(
+        ID3D11Resource*               pResource,
+        UINT                          Subresource,
+        D3D11_MAP                     MapType,
+        UINT                          MapFlags,
+        D3D11_MAPPED_SUBRESOURCE*     pMappedResource) {
+  HRESULT hr = m_ctx->Map(pResource, Subresource, MapType, MapFlags, pMappedResource);
+  
+  if (SUCCEEDED(hr) && pMappedResource && MapType != D3D11_MAP_READ
+   && agsIsDrawCountBuffer(m_context, pResource)) {
+    // Discarded contents are undefined, so the
+    // app must write every count it uses anyway
+    if (MapType == D3D11_MAP_WRITE_DISCARD)
+      agsHookBufferInvalidate(m_context, pResource);
+    
+    m_mappedDrawCounts.push_back({ pResource, pMappedResource->pData });
+  }
+  
+  return hr;
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Unmap(
+        ID3D11Resource*               pResource,
+        UINT                          Subresource) {
+  for (auto entry = m_mappedDrawCounts.begin(); entry != m_mappedDrawCounts.end(); entry++) {
+    if (entry->first == pResource) {
+      agsHookBufferWrite(m_context, pResource, nullptr, entry->second, false);
+      m_mappedDrawCounts.erase(entry);
+      break;
+    }
+  }
+  
+  m_ctx->Unmap(pResource, Subresource);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->PSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IASetInputLayout(
+        ID3D11InputLayout*            pInputLayout) {
+  m_ctx->IASetInputLayout(pInputLayout);
+  
+  agsHookStateChange(m_context, AgsStateInputAssembly);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IASetVertexBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppVertexBuffers,
+  const UINT*                         pStrides,
+  const UINT*                         pOffsets) {
+  m_ctx->IASetVertexBuffers(
+    StartSlot,
+    NumBuffers,
+    ppVertexBuffers,
+    pStrides,
+    pOffsets);
+  
+  agsHookStateChange(m_context, AgsStateInputAssembly);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IASetIndexBuffer(
+        ID3D11Buffer*                 pIndexBuffer,
+        DXGI_FORMAT                   Format,
+        UINT                          Offset) {
+  m_ctx->IASetIndexBuffer(pIndexBuffer, Format, Offset);
+  
+  agsHookStateChange(m_context, AgsStateInputAssembly);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawIndexedInstanced(
+        UINT                          IndexCountPerInstance,
+        UINT                          InstanceCount,
+        UINT                          StartIndexLocation,
+        INT                           BaseVertexLocation,
+        UINT                          StartInstanceLocation) {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawIndexedInstanced(
+    IndexCountPerInstance,
+    InstanceCount,
+    StartIndexLocation,
+    BaseVertexLocation,
+    StartInstanceLocation);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawInstanced(
+        UINT                          VertexCountPerInstance,
+        UINT                          InstanceCount,
+        UINT                          StartVertexLocation,
+        UINT                          StartInstanceLocation) {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawInstanced(
+    VertexCountPerInstance,
+    InstanceCount,
+    StartVertexLocation,
+    StartInstanceLocation);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->GSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSSetShader(
+        ID3D11GeometryShader*         pShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->GSSetShader(pShader, ppClassInstances, NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IASetPrimitiveTopology(
+        D3D11_PRIMITIVE_TOPOLOGY      Topology) {
+  m_ctx->IASetPrimitiveTopology(Topology);
+  
+  agsHookStateChange(m_context, AgsStateInputAssembly);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->VSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->VSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Begin(
+        ID3D11Asynchronous*           pAsync) {
+  m_ctx->Begin(pAsync);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::End(
+        ID3D11Asynchronous*           pAsync) {
+  m_ctx->End(pAsync);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::GetData(
+        ID3D11Asynchronous*           pAsync,
+        void*                         pData,
+        UINT                          DataSize,
+        UINT                          GetDataFlags) {
+  return m_ctx->GetData(pAsync, pData, DataSize, GetDataFlags);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SetPredication(
+        ID3D11Predicate*              pPredicate,
+        BOOL                          PredicateValue) {
+  m_ctx->SetPredication(pPredicate, PredicateValue);
+  
+  agsHookStateChange(m_context, AgsStatePredication);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->GSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->GSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMSetRenderTargets(
+        UINT                          NumViews,
+        ID3D11RenderTargetView* const* ppRenderTargetViews,
+        ID3D11DepthStencilView*       pDepthStencilView) {
+  m_ctx->OMSetRenderTargets(
+    NumViews,
+    ppRenderTargetViews,
+    pDepthStencilView);
+  
+  agsHookStateChange(m_context, AgsStateOutputMerger);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMSetRenderTargetsAndUnorderedAccessViews(
+        UINT                          NumRTVs,
+        ID3D11RenderTargetView* const* ppRenderTargetViews,
+        ID3D11DepthStencilView*       pDepthStencilView,
+        UINT                          UAVStartSlot,
+        UINT                          NumUAVs,
+        ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+  const UINT*                         pUAVInitialCounts) {
+  m_ctx->OMSetRenderTargetsAndUnorderedAccessViews(
+    NumRTVs,
+    ppRenderTargetViews,
+    pDepthStencilView,
+    UAVStartSlot,
+    NumUAVs,
+    ppUnorderedAccessViews,
+    pUAVInitialCounts);
+  
+  agsHookStateChange(m_context, AgsStateOutputMerger | AgsStateUavs);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMSetBlendState(
+        ID3D11BlendState*             pBlendState,
+  const FLOAT                         BlendFactor[4],
+        UINT                          SampleMask) {
+  m_ctx->OMSetBlendState(pBlendState, BlendFactor, SampleMask);
+  
+  agsHookStateChange(m_context, AgsStateOutputMerger);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMSetDepthStencilState(
+        ID3D11DepthStencilState*      pDepthStencilState,
+        UINT                          StencilRef) {
+  m_ctx->OMSetDepthStencilState(pDepthStencilState, StencilRef);
+  
+  agsHookStateChange(m_context, AgsStateOutputMerger);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SOSetTargets(
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppSOTargets,
+  const UINT*                         pOffsets) {
+  m_ctx->SOSetTargets(NumBuffers, ppSOTargets, pOffsets);
+  
+  agsHookStateChange(m_context, AgsStateStreamOutput);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawAuto() {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawAuto();
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawIndexedInstancedIndirect(
+        ID3D11Buffer*                 pBufferForArgs,
+        UINT                          AlignedByteOffsetForArgs) {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawIndexedInstancedIndirect(
+    pBufferForArgs,
+    AlignedByteOffsetForArgs);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DrawInstancedIndirect(
+        ID3D11Buffer*                 pBufferForArgs,
+        UINT                          AlignedByteOffsetForArgs) {
+  agsHookDraw(m_context);
+  
+  m_ctx->DrawInstancedIndirect(pBufferForArgs, AlignedByteOffsetForArgs);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Dispatch(
+        UINT                          ThreadGroupCountX,
+        UINT                          ThreadGroupCountY,
+        UINT                          ThreadGroupCountZ) {
+  agsHookDispatch(m_context);
+  
+  m_ctx->Dispatch(
+    ThreadGroupCountX,
+    ThreadGroupCountY,
+    ThreadGroupCountZ);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DispatchIndirect(
+        ID3D11Buffer*                 pBufferForArgs,
+        UINT                          AlignedByteOffsetForArgs) {
+  agsHookDispatch(m_context);
+  
+  m_ctx->DispatchIndirect(pBufferForArgs, AlignedByteOffsetForArgs);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSSetState(
+        ID3D11RasterizerState*        pRasterizerState) {
+  m_ctx->RSSetState(pRasterizerState);
+  
+  agsHookStateChange(m_context, AgsStateRasterizer);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSSetViewports(
+        UINT                          NumViewports,
+  const D3D11_VIEWPORT*               pViewports) {
+  m_ctx->RSSetViewports(NumViewports, pViewports);
+  
+  agsHookStateChange(m_context, AgsStateRasterizer);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSSetScissorRects(
+        UINT                          NumRects,
+  const D3D11_RECT*                   pRects) {
+  m_ctx->RSSetScissorRects(NumRects, pRects);
+  
+  agsHookStateChange(m_context, AgsStateRasterizer);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CopySubresourceRegion(
+        ID3D11Resource*               pDstResource,
+        UINT                          DstSubresource,
+        UINT                          DstX,
+        UINT                          DstY,
+        UINT                          DstZ,
+        ID3D11Resource*               pSrcResource,
+        UINT                          SrcSubresource,
+  const D3D11_BOX*                    pSrcBox) {
+  agsHookBufferInvalidate(m_context, pDstResource);
+  
+  m_ctx->CopySubresourceRegion(
+    pDstResource,
+    DstSubresource,
+    DstX,
+    DstY,
+    DstZ,
+    pSrcResource,
+    SrcSubresource,
+    pSrcBox);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CopyResource(
+        ID3D11Resource*               pDstResource,
+        ID3D11Resource*               pSrcResource) {
+  agsHookBufferInvalidate(m_context, pDstResource);
+  
+  m_ctx->CopyResource(pDstResource, pSrcResource);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::UpdateSubresource(
+        ID3D11Resource*               pDstResource,
+        UINT                          DstSubresource,
+  const D3D11_BOX*                    pDstBox,
+  const void*                         pSrcData,
+        UINT                          SrcRowPitch,
+        UINT                          SrcDepthPitch) {
+  agsHookBufferWrite(m_context, pDstResource, pDstBox, pSrcData, false);
+  
+  m_ctx->UpdateSubresource(
+    pDstResource,
+    DstSubresource,
+    pDstBox,
+    pSrcData,
+    SrcRowPitch,
+    SrcDepthPitch);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CopyStructureCount(
+        ID3D11Buffer*                 pDstBuffer,
+        UINT                          DstAlignedByteOffset,
+        ID3D11UnorderedAccessView*    pSrcView) {
+  agsHookBufferInvalidate(m_context, pDstBuffer);
+  
+  m_ctx->CopyStructureCount(pDstBuffer, DstAlignedByteOffset, pSrcView);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearRenderTargetView(
+        ID3D11RenderTargetView*       pRenderTargetView,
+  const FLOAT                         ColorRGBA[4]) {
+  m_ctx->ClearRenderTargetView(pRenderTargetView, ColorRGBA);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearUnorderedAccessViewUint(
+        ID3D11UnorderedAccessView*    pUnorderedAccessView,
+  const UINT                          Values[4]) {
+  m_ctx->ClearUnorderedAccessViewUint(pUnorderedAccessView, Values);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearUnorderedAccessViewFloat(
+        ID3D11UnorderedAccessView*    pUnorderedAccessView,
+  const FLOAT                         Values[4]) {
+  m_ctx->ClearUnorderedAccessViewFloat(pUnorderedAccessView, Values);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearDepthStencilView(
+        ID3D11DepthStencilView*       pDepthStencilView,
+        UINT                          ClearFlags,
+        FLOAT                         Depth,
+        UINT8                         Stencil) {
+  m_ctx->ClearDepthStencilView(
+    pDepthStencilView,
+    ClearFlags,
+    Depth,
+    Stencil);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GenerateMips(
+        ID3D11ShaderResourceView*     pShaderResourceView) {
+  m_ctx->GenerateMips(pShaderResourceView);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SetResourceMinLOD(
+        ID3D11Resource*               pResource,
+        FLOAT                         MinLOD) {
+  m_ctx->SetResourceMinLOD(pResource, MinLOD);
+}
+
+
+FLOAT STDMETHODCALLTYPE AgsDeviceContext::GetResourceMinLOD(
+        ID3D11Resource*               pResource) {
+  return m_ctx->GetResourceMinLOD(pResource);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ResolveSubresource(
+        ID3D11Resource*               pDstResource,
+        UINT                          DstSubresource,
+        ID3D11Resource*               pSrcResource,
+        UINT                          SrcSubresource,
+        DXGI_FORMAT                   Format) {
+  m_ctx->ResolveSubresource(
+    pDstResource,
+    DstSubresource,
+    pSrcResource,
+    SrcSubresource,
+    Format);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ExecuteCommandList(
+        ID3D11CommandList*            pCommandList,
+        BOOL                          RestoreContextState) {
+  m_ctx->ExecuteCommandList(pCommandList, RestoreContextState);
+  
+  // Command lists may write to any buffer
+  m_context->drawCountEpoch += 1;
+  
+  if (!RestoreContextState)
+    agsHookStateChange(m_context, AgsStateAll);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->HSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSSetShader(
+        ID3D11HullShader*             pHullShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->HSSetShader(pHullShader, ppClassInstances, NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->HSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->HSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->DSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSSetShader(
+        ID3D11DomainShader*           pDomainShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->DSSetShader(pDomainShader, ppClassInstances, NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->DSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->DSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+  m_ctx->CSSetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetUnorderedAccessViews(
+        UINT                          StartSlot,
+        UINT                          NumUAVs,
+        ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+  const UINT*                         pUAVInitialCounts) {
+  m_ctx->CSSetUnorderedAccessViews(
+    StartSlot,
+    NumUAVs,
+    ppUnorderedAccessViews,
+    pUAVInitialCounts);
+  
+  agsHookStateChange(m_context, AgsStateUavs);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetShader(
+        ID3D11ComputeShader*          pComputeShader,
+        ID3D11ClassInstance* const*   ppClassInstances,
+        UINT                          NumClassInstances) {
+  m_ctx->CSSetShader(
+    pComputeShader,
+    ppClassInstances,
+    NumClassInstances);
+  
+  agsHookStateChange(m_context, AgsStateShaders);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState* const*    ppSamplers) {
+  m_ctx->CSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers) {
+  m_ctx->CSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->VSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->PSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSGetShader(
+        ID3D11PixelShader**           ppPixelShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->PSGetShader(
+    ppPixelShader,
+    ppClassInstances,
+    pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->PSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSGetShader(
+        ID3D11VertexShader**          ppVertexShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->VSGetShader(
+    ppVertexShader,
+    ppClassInstances,
+    pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->PSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IAGetInputLayout(
+        ID3D11InputLayout**           ppInputLayout) {
+  m_ctx->IAGetInputLayout(ppInputLayout);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IAGetVertexBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppVertexBuffers,
+        UINT*                         pStrides,
+        UINT*                         pOffsets) {
+  m_ctx->IAGetVertexBuffers(
+    StartSlot,
+    NumBuffers,
+    ppVertexBuffers,
+    pStrides,
+    pOffsets);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IAGetIndexBuffer(
+        ID3D11Buffer**                ppIndexBuffer,
+        DXGI_FORMAT*                  pFormat,
+        UINT*                         pOffset) {
+  m_ctx->IAGetIndexBuffer(ppIndexBuffer, pFormat, pOffset);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->GSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSGetShader(
+        ID3D11GeometryShader**        ppGeometryShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->GSGetShader(
+    ppGeometryShader,
+    ppClassInstances,
+    pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::IAGetPrimitiveTopology(
+        D3D11_PRIMITIVE_TOPOLOGY*     pTopology) {
+  m_ctx->IAGetPrimitiveTopology(pTopology);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->VSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->VSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GetPredication(
+        ID3D11Predicate**             ppPredicate,
+        BOOL*                         pPredicateValue) {
+  m_ctx->GetPredication(ppPredicate, pPredicateValue);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->GSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->GSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMGetRenderTargets(
+        UINT                          NumViews,
+        ID3D11RenderTargetView**      ppRenderTargetViews,
+        ID3D11DepthStencilView**      ppDepthStencilView) {
+  m_ctx->OMGetRenderTargets(
+    NumViews,
+    ppRenderTargetViews,
+    ppDepthStencilView);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMGetRenderTargetsAndUnorderedAccessViews(
+        UINT                          NumRTVs,
+        ID3D11RenderTargetView**      ppRenderTargetViews,
+        ID3D11DepthStencilView**      ppDepthStencilView,
+        UINT                          UAVStartSlot,
+        UINT                          NumUAVs,
+        ID3D11UnorderedAccessView**   ppUnorderedAccessViews) {
+  m_ctx->OMGetRenderTargetsAndUnorderedAccessViews(
+    NumRTVs,
+    ppRenderTargetViews,
+    ppDepthStencilView,
+    UAVStartSlot,
+    NumUAVs,
+    ppUnorderedAccessViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMGetBlendState(
+        ID3D11BlendState**            ppBlendState,
+        FLOAT                         BlendFactor[4],
+        UINT*                         pSampleMask) {
+  m_ctx->OMGetBlendState(ppBlendState, BlendFactor, pSampleMask);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::OMGetDepthStencilState(
+        ID3D11DepthStencilState**     ppDepthStencilState,
+        UINT*                         pStencilRef) {
+  m_ctx->OMGetDepthStencilState(ppDepthStencilState, pStencilRef);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SOGetTargets(
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppSOTargets) {
+  m_ctx->SOGetTargets(NumBuffers, ppSOTargets);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSGetState(
+        ID3D11RasterizerState**       ppRasterizerState) {
+  m_ctx->RSGetState(ppRasterizerState);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSGetViewports(
+        UINT*                         pNumViewports,
+        D3D11_VIEWPORT*               pViewports) {
+  m_ctx->RSGetViewports(pNumViewports, pViewports);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::RSGetScissorRects(
+        UINT*                         pNumRects,
+        D3D11_RECT*                   pRects) {
+  m_ctx->RSGetScissorRects(pNumRects, pRects);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->HSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSGetShader(
+        ID3D11HullShader**            ppHullShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->HSGetShader(ppHullShader, ppClassInstances, pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->HSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->HSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->DSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSGetShader(
+        ID3D11DomainShader**          ppDomainShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->DSGetShader(
+    ppDomainShader,
+    ppClassInstances,
+    pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->DSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->DSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetShaderResources(
+        UINT                          StartSlot,
+        UINT                          NumViews,
+        ID3D11ShaderResourceView**    ppShaderResourceViews) {
+  m_ctx->CSGetShaderResources(
+    StartSlot,
+    NumViews,
+    ppShaderResourceViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetUnorderedAccessViews(
+        UINT                          StartSlot,
+        UINT                          NumUAVs,
+        ID3D11UnorderedAccessView**   ppUnorderedAccessViews) {
+  m_ctx->CSGetUnorderedAccessViews(
+    StartSlot,
+    NumUAVs,
+    ppUnorderedAccessViews);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetShader(
+        ID3D11ComputeShader**         ppComputeShader,
+        ID3D11ClassInstance**         ppClassInstances,
+        UINT*                         pNumClassInstances) {
+  m_ctx->CSGetShader(
+    ppComputeShader,
+    ppClassInstances,
+    pNumClassInstances);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetSamplers(
+        UINT                          StartSlot,
+        UINT                          NumSamplers,
+        ID3D11SamplerState**          ppSamplers) {
+  m_ctx->CSGetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetConstantBuffers(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers) {
+  m_ctx->CSGetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearState() {
+  m_ctx->ClearState();
+  
+  agsHookStateChange(m_context, AgsStateAll);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Flush() {
+  m_ctx->Flush();
+}
+
+
+D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE AgsDeviceContext::GetType() {
+  return m_ctx->GetType();
+}
+
+
+UINT STDMETHODCALLTYPE AgsDeviceContext::GetContextFlags() {
+  return m_ctx->GetContextFlags();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::FinishCommandList(
+        BOOL                          RestoreDeferredContextState,
+        ID3D11CommandList**           ppCommandList) {
+  return m_ctx->FinishCommandList(RestoreDeferredContextState, ppCommandList);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CopySubresourceRegion1(
+        ID3D11Resource*               pDstResource,
+        UINT                          DstSubresource,
+        UINT                          DstX,
+        UINT                          DstY,
+        UINT                          DstZ,
+        ID3D11Resource*               pSrcResource,
+        UINT                          SrcSubresource,
+  const D3D11_BOX*                    pSrcBox,
+        UINT                          CopyFlags) {
+  agsHookBufferInvalidate(m_context, pDstResource);
+  
+  m_ctx->CopySubresourceRegion1(
+    pDstResource,
+    DstSubresource,
+    DstX,
+    DstY,
+    DstZ,
+    pSrcResource,
+    SrcSubresource,
+    pSrcBox,
+    CopyFlags);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::UpdateSubresource1(
+        ID3D11Resource*               pDstResource,
+        UINT                          DstSubresource,
+  const D3D11_BOX*                    pDstBox,
+  const void*                         pSrcData,
+        UINT                          SrcRowPitch,
+        UINT                          SrcDepthPitch,
+        UINT                          CopyFlags) {
+  agsHookBufferWrite(m_context, pDstResource, pDstBox, pSrcData, CopyFlags & D3D11_COPY_DISCARD);
+  
+  m_ctx->UpdateSubresource1(
+    pDstResource,
+    DstSubresource,
+    pDstBox,
+    pSrcData,
+    SrcRowPitch,
+    SrcDepthPitch,
+    CopyFlags);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DiscardResource(
+        ID3D11Resource*               pResource) {
+  agsHookBufferInvalidate(m_context, pResource);
+  
+  m_ctx->DiscardResource(pResource);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DiscardView(
+        ID3D11View*                   pResourceView) {
+  agsHookViewInvalidate(m_context, pResourceView);
+  
+  m_ctx->DiscardView(pResourceView);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->VSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->HSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->DSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->GSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->PSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSSetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer* const*          ppConstantBuffers,
+  const UINT*                         pFirstConstant,
+  const UINT*                         pNumConstants) {
+  m_ctx->CSSetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+  
+  agsHookStateChange(m_context, AgsStateResources);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::VSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->VSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::HSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->HSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->DSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->GSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::PSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->PSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CSGetConstantBuffers1(
+        UINT                          StartSlot,
+        UINT                          NumBuffers,
+        ID3D11Buffer**                ppConstantBuffers,
+        UINT*                         pFirstConstant,
+        UINT*                         pNumConstants) {
+  m_ctx->CSGetConstantBuffers1(
+    StartSlot,
+    NumBuffers,
+    ppConstantBuffers,
+    pFirstConstant,
+    pNumConstants);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SwapDeviceContextState(
+        ID3DDeviceContextState*       pState,
+        ID3DDeviceContextState**      ppPreviousState) {
+  m_ctx->SwapDeviceContextState(pState, ppPreviousState);
+  
+  agsHookStateChange(m_context, AgsStateAll);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::ClearView(
+        ID3D11View*                   pView,
+  const FLOAT                         Color[4],
+  const D3D11_RECT*                   pRect,
+        UINT                          NumRects) {
+  m_ctx->ClearView(pView, Color, pRect, NumRects);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::DiscardView1(
+        ID3D11View*                   pResourceView,
+  const D3D11_RECT*                   pRects,
+        UINT                          NumRects) {
+  agsHookViewInvalidate(m_context, pResourceView);
+  
+  m_ctx->DiscardView1(pResourceView, pRects, NumRects);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::UpdateTileMappings(
+        ID3D11Resource*               pTiledResource,
+        UINT                          NumTiledResourceRegions,
+  const D3D11_TILED_RESOURCE_COORDINATE* pTiledResourceRegionStartCoordinates,
+  const D3D11_TILE_REGION_SIZE*       pTiledResourceRegionSizes,
+        ID3D11Buffer*                 pTilePool,
+        UINT                          NumRanges,
+  const UINT*                         pRangeFlags,
+  const UINT*                         pTilePoolStartOffsets,
+  const UINT*                         pRangeTileCounts,
+        UINT                          Flags) {
+  agsHookBufferInvalidate(m_context, pTiledResource);
+  
+  return m_ctx->UpdateTileMappings(
+    pTiledResource,
+    NumTiledResourceRegions,
+    pTiledResourceRegionStartCoordinates,
+    pTiledResourceRegionSizes,
+    pTilePool,
+    NumRanges,
+    pRangeFlags,
+    pTilePoolStartOffsets,
+    pRangeTileCounts,
+    Flags);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::CopyTileMappings(
+        ID3D11Resource*               pDestTiledResource,
+  const D3D11_TILED_RESOURCE_COORDINATE* pDestRegionStartCoordinate,
+        ID3D11Resource*               pSourceTiledResource,
+  const D3D11_TILED_RESOURCE_COORDINATE* pSourceRegionStartCoordinate,
+  const D3D11_TILE_REGION_SIZE*       pTileRegionSize,
+        UINT                          Flags) {
+  agsHookBufferInvalidate(m_context, pDestTiledResource);
+  
+  return m_ctx->CopyTileMappings(
+    pDestTiledResource,
+    pDestRegionStartCoordinate,
+    pSourceTiledResource,
+    pSourceRegionStartCoordinate,
+    pTileRegionSize,
+    Flags);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::CopyTiles(
+        ID3D11Resource*               pTiledResource,
+  const D3D11_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate,
+  const D3D11_TILE_REGION_SIZE*       pTileRegionSize,
+        ID3D11Buffer*                 pBuffer,
+        UINT64                        BufferStartOffsetInBytes,
+        UINT                          Flags) {
+  if (Flags & D3D11_TILE_COPY_LINEAR_BUFFER_TO_SWIZZLED_TILED_RESOURCE)
+    agsHookBufferInvalidate(m_context, pTiledResource);
+  else
+    agsHookBufferInvalidate(m_context, pBuffer);
+  
+  m_ctx->CopyTiles(
+    pTiledResource,
+    pTileRegionStartCoordinate,
+    pTileRegionSize,
+    pBuffer,
+    BufferStartOffsetInBytes,
+    Flags);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::UpdateTiles(
+        ID3D11Resource*               pDestTiledResource,
+  const D3D11_TILED_RESOURCE_COORDINATE* pDestTileRegionStartCoordinate,
+  const D3D11_TILE_REGION_SIZE*       pDestTileRegionSize,
+  const void*                         pSourceTileData,
+        UINT                          Flags) {
+  agsHookBufferInvalidate(m_context, pDestTiledResource);
+  
+  m_ctx->UpdateTiles(
+    pDestTiledResource,
+    pDestTileRegionStartCoordinate,
+    pDestTileRegionSize,
+    pSourceTileData,
+    Flags);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::ResizeTilePool(
+        ID3D11Buffer*                 pTilePool,
+        UINT64                        NewSizeInBytes) {
+  return m_ctx->ResizeTilePool(pTilePool, NewSizeInBytes);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::TiledResourceBarrier(
+        ID3D11DeviceChild*            pTiledResourceOrViewAccessBeforeBarrier,
+        ID3D11DeviceChild*            pTiledResourceOrViewAccessAfterBarrier) {
+  m_ctx->TiledResourceBarrier(
+    pTiledResourceOrViewAccessBeforeBarrier,
+    pTiledResourceOrViewAccessAfterBarrier);
+}
+
+
+BOOL STDMETHODCALLTYPE AgsDeviceContext::IsAnnotationEnabled() {
+  return m_ctx->IsAnnotationEnabled();
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SetMarkerInt(
+        LPCWSTR                       pLabel,
+        INT                           Data) {
+  m_ctx->SetMarkerInt(pLabel, Data);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::BeginEventInt(
+        LPCWSTR                       pLabel,
+        INT                           Data) {
+  m_ctx->BeginEventInt(pLabel, Data);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::EndEvent() {
+  m_ctx->EndEvent();
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::Flush1(
+        D3D11_CONTEXT_TYPE            ContextType,
+        HANDLE                        hEvent) {
+  m_ctx->Flush1(ContextType, hEvent);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::SetHardwareProtectionState(
+        BOOL                          HwProtectionEnable) {
+  m_ctx->SetHardwareProtectionState(HwProtectionEnable);
+}
+
+
+void STDMETHODCALLTYPE AgsDeviceContext::GetHardwareProtectionState(
+        BOOL*                         pHwProtectionEnable) {
+  m_ctx->GetHardwareProtectionState(pHwProtectionEnable);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::Signal(
+        ID3D11Fence*                  pFence,
+        UINT64                        Value) {
+  return m_ctx->Signal(pFence, Value);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsDeviceContext::Wait(
+        ID3D11Fence*                  pFence,
+        UINT64                        Value) {
+  return m_ctx->Wait(pFence, Value);
+}
+
+
+AgsSwapChain::AgsSwapChain(
+        AGSContext*                   context,
+        IDXGISwapChain4*              swapChain)
+: m_context(context), m_swapChain(swapChain) {
+
+}
+
+
+AgsSwapChain::~AgsSwapChain() {
+  m_swapChain->Release();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::QueryInterface(
+        REFIID                        riid,
+        void**                        ppvObject) {
+  if (!ppvObject)
+    return E_POINTER;
+  
+  if (riid == __uuidof(IUnknown)
+   || riid == __uuidof(IDXGIObject)
+   || riid == __uuidof(IDXGIDeviceSubObject)
+   || riid == __uuidof(IDXGISwapChain)
+   || riid == __uuidof(IDXGISwapChain1)
+   || riid == __uuidof(IDXGISwapChain2)
+   || riid == __uuidof(IDXGISwapChain3)
+   || riid == __uuidof(IDXGISwapChain4)) {
+    *ppvObject = static_cast<IDXGISwapChain4*>(this);
+    AddRef();
+    return S_OK;
+  }
+  
+  return m_swapChain->QueryInterface(riid, ppvObject);
+}
+
+
+ULONG STDMETHODCALLTYPE AgsSwapChain::AddRef() {
+  return ++m_refCount;
+}
+
+
+ULONG STDMETHODCALLTYPE AgsSwapChain::Release() {
+  ULONG refCount = --m_refCount;
+  
+  if (!refCount)
+    delete this;
+  
+  return refCount;
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::Present(
+        UINT                          SyncInterval,
+        UINT                          Flags) {
+  if (!(Flags & DXGI_PRESENT_TEST))
+    agsHookPresent(m_context);
+  
+  return m_swapChain->Present(SyncInterval, Flags);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::Present1(
+        UINT                          SyncInterval,
+        UINT                          PresentFlags,
+  const DXGI_PRESENT_PARAMETERS*      pPresentParameters) {
+  if (!(PresentFlags & DXGI_PRESENT_TEST))
+    agsHookPresent(m_context);
+  
+  return m_swapChain->Present1(SyncInterval, PresentFlags, pPresentParameters);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetPrivateData(
+        REFGUID                       Name,
+        UINT                          DataSize,
+  const void*                         pData) {
+  return m_swapChain->SetPrivateData(Name, DataSize, pData);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetPrivateDataInterface(
+        REFGUID                       Name,
+  const IUnknown*                     pUnknown) {
+  return m_swapChain->SetPrivateDataInterface(Name, pUnknown);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetPrivateData(
+        REFGUID                       Name,
+        UINT*                         pDataSize,
+        void*                         pData) {
+  return m_swapChain->GetPrivateData(Name, pDataSize, pData);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetParent(
+        REFIID                        riid,
+        void**                        ppParent) {
+  return m_swapChain->GetParent(riid, ppParent);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetDevice(
+        REFIID                        riid,
+        void**                        ppDevice) {
+  return m_swapChain->GetDevice(riid, ppDevice);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetBuffer(
+        UINT                          Buffer,
+        REFIID                        riid,
+        void**                        ppSurface) {
+  return m_swapChain->GetBuffer(Buffer, riid, ppSurface);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetFullscreenState(
+        BOOL                          Fullscreen,
+        IDXGIOutput*                  pTarget) {
+  return m_swapChain->SetFullscreenState(Fullscreen, pTarget);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetFullscreenState(
+        BOOL*                         pFullscreen,
+        IDXGIOutput**                 ppTarget) {
+  return m_swapChain->GetFullscreenState(pFullscreen, ppTarget);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetDesc(
+        DXGI_SWAP_CHAIN_DESC*         pDesc) {
+  return m_swapChain->GetDesc(pDesc);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::ResizeBuffers(
+        UINT                          BufferCount,
+        UINT                          Width,
+        UINT                          Height,
+        DXGI_FORMAT                   NewFormat,
+        UINT                          SwapChainFlags) {
+  return m_swapChain->ResizeBuffers(
+    BufferCount,
+    Width,
+    Height,
+    NewFormat,
+    SwapChainFlags);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::ResizeTarget(
+  const DXGI_MODE_DESC*               pNewTargetParameters) {
+  return m_swapChain->ResizeTarget(pNewTargetParameters);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetContainingOutput(
+        IDXGIOutput**                 ppOutput) {
+  return m_swapChain->GetContainingOutput(ppOutput);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetFrameStatistics(
+        DXGI_FRAME_STATISTICS*        pStats) {
+  return m_swapChain->GetFrameStatistics(pStats);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetLastPresentCount(
+        UINT*                         pLastPresentCount) {
+  return m_swapChain->GetLastPresentCount(pLastPresentCount);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetDesc1(
+        DXGI_SWAP_CHAIN_DESC1*        pDesc) {
+  return m_swapChain->GetDesc1(pDesc);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetFullscreenDesc(
+        DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pDesc) {
+  return m_swapChain->GetFullscreenDesc(pDesc);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetHwnd(
+        HWND*                         pHwnd) {
+  return m_swapChain->GetHwnd(pHwnd);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetCoreWindow(
+        REFIID                        riid,
+        void**                        ppUnk) {
+  return m_swapChain->GetCoreWindow(riid, ppUnk);
+}
+
+
+BOOL STDMETHODCALLTYPE AgsSwapChain::IsTemporaryMonoSupported() {
+  return m_swapChain->IsTemporaryMonoSupported();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetRestrictToOutput(
+        IDXGIOutput**                 ppRestrictToOutput) {
+  return m_swapChain->GetRestrictToOutput(ppRestrictToOutput);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetBackgroundColor(
+  const DXGI_RGBA*                    pColor) {
+  return m_swapChain->SetBackgroundColor(pColor);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetBackgroundColor(
+        DXGI_RGBA*                    pColor) {
+  return m_swapChain->GetBackgroundColor(pColor);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetRotation(
+        DXGI_MODE_ROTATION            Rotation) {
+  return m_swapChain->SetRotation(Rotation);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetRotation(
+        DXGI_MODE_ROTATION*           pRotation) {
+  return m_swapChain->GetRotation(pRotation);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetSourceSize(
+        UINT                          Width,
+        UINT                          Height) {
+  return m_swapChain->SetSourceSize(Width, Height);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetSourceSize(
+        UINT*                         pWidth,
+        UINT*                         pHeight) {
+  return m_swapChain->GetSourceSize(pWidth, pHeight);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetMaximumFrameLatency(
+        UINT                          MaxLatency) {
+  return m_swapChain->SetMaximumFrameLatency(MaxLatency);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetMaximumFrameLatency(
+        UINT*                         pMaxLatency) {
+  return m_swapChain->GetMaximumFrameLatency(pMaxLatency);
+}
+
+
+HANDLE STDMETHODCALLTYPE AgsSwapChain::GetFrameLatencyWaitableObject() {
+  return m_swapChain->GetFrameLatencyWaitableObject();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetMatrixTransform(
+  const DXGI_MATRIX_3X2_F*            pMatrix) {
+  return m_swapChain->SetMatrixTransform(pMatrix);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::GetMatrixTransform(
+        DXGI_MATRIX_3X2_F*            pMatrix) {
+  return m_swapChain->GetMatrixTransform(pMatrix);
+}
+
+
+UINT STDMETHODCALLTYPE AgsSwapChain::GetCurrentBackBufferIndex() {
+  return m_swapChain->GetCurrentBackBufferIndex();
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::CheckColorSpaceSupport(
+        DXGI_COLOR_SPACE_TYPE         ColorSpace,
+        UINT*                         pColorSpaceSupport) {
+  return m_swapChain->CheckColorSpaceSupport(ColorSpace, pColorSpaceSupport);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetColorSpace1(
+        DXGI_COLOR_SPACE_TYPE         ColorSpace) {
+  return m_swapChain->SetColorSpace1(ColorSpace);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::ResizeBuffers1(
+        UINT                          BufferCount,
+        UINT                          Width,
+        UINT                          Height,
+        DXGI_FORMAT                   Format,
+        UINT                          SwapChainFlags,
+  const UINT*                         pCreationNodeMask,
+        IUnknown* const*              ppPresentQueue) {
+  return m_swapChain->ResizeBuffers1(
+    BufferCount,
+    Width,
+    Height,
+    Format,
+    SwapChainFlags,
+    pCreationNodeMask,
+    ppPresentQueue);
+}
+
+
+HRESULT STDMETHODCALLTYPE AgsSwapChain::SetHDRMetaData(
+        DXGI_HDR_METADATA_TYPE        Type,
+        UINT                          Size,
+        void*                         pMetaData) {
+  return m_swapChain->SetHDRMetaData(Type, Size, pMetaData);
+}
@@ -0,0 +1,994 @@
+#pragma once
+
+#include "ags_private.h"
+
+/**
+ * \brief Context state flags
+ * 
+ * Passed to the state change hook in order to
+ * tell which part of the context state changed.
+ */
+enum AgsStateChange : uint32_t {
+  AgsStateShaders         = 1u << 0,
+  AgsStateResources       = 1u << 1,
+  AgsStateUavs            = 1u << 2,
+  AgsStateInputAssembly   = 1u << 3,
+  AgsStateRasterizer      = 1u << 4,
+  AgsStateOutputMerger    = 1u << 5,
+  AgsStateStreamOutput    = 1u << 6,
+  AgsStatePredication     = 1u << 7,
+  AgsStateAll             = 0xffu,
+};
+
+
+/**
+ * \brief Looks up a draw count written by the CPU
+ * 
+ * Count buffers are registered on first use. Writes to
+ * them through \c UpdateSubresource or \c Map on the
+ * wrapped immediate context are shadowed from then on,
+ * as long as the GPU cannot write to the buffer. Copies
+ * into the buffer and command lists invalidate the
+ * shadow copy, so the count is only known if it was
+ * last written by the CPU.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context the call is recorded into
+ * \param [in] buffer Draw count buffer
+ * \param [in] offset Offset of the draw count
+ * \param [out] drawCount Draw count, if known
+ * \returns \c true if the draw count is known
+ */
+bool agsInterposerGetDrawCount(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        ID3D11Buffer*                 buffer,
+        uint32_t                      offset,
+        uint32_t*                     drawCount);
+
+
+/**
+ * \brief Immediate context wrapper
+ * 
+ * Forwards all calls to the wrapped DXVK context and
+ * invokes the interposer hooks for draws, dispatches
+ * and state changes. Queries for any interface other
+ * than \c ID3D11DeviceContext4 and its base interfaces
+ * are answered by the wrapped context, so that DXVK
+ * extension interfaces keep working.
+ */
+class AgsDeviceContext final : public ID3D11DeviceContext4 {
+
+public:
+
+  AgsDeviceContext(
+          AGSContext*                   context,
+          ID3D11DeviceContext4*         ctx);
+  
+  ~AgsDeviceContext();
+  
+  HRESULT STDMETHODCALLTYPE QueryInterface(
+          REFIID                        riid,
+          void**                        ppvObject) final;
+  
+  ULONG STDMETHODCALLTYPE AddRef() final;
+  
+  ULONG STDMETHODCALLTYPE Release() final;
+  
+  void STDMETHODCALLTYPE GetDevice(
+          ID3D11Device**                ppDevice) final;
+  
+  HRESULT STDMETHODCALLTYPE GetPrivateData(
+          REFGUID                       guid,
+          UINT*                         pDataSize,
+          void*                         pData) final;
+  
+  HRESULT STDMETHODCALLTYPE SetPrivateData(
+          REFGUID                       guid,
+          UINT                          DataSize,
+    const void*                         pData) final;
+  
+  HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(
+          REFGUID                       guid,
+    const IUnknown*                     pData) final;
+  
+  void STDMETHODCALLTYPE VSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE PSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE PSSetShader(
+          ID3D11PixelShader*            pPixelShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE PSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE VSSetShader(
+          ID3D11VertexShader*           pVertexShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE DrawIndexed(
+          UINT                          IndexCount,
+          UINT                          StartIndexLocation,
+          INT                           BaseVertexLocation) final;
+  
+  void STDMETHODCALLTYPE Draw(
+          UINT                          VertexCount,
+          UINT                          StartVertexLocation) final;
+  
+  HRESULT STDMETHODCALLTYPE Map(
+          ID3D11Resource*               pResource,
+          UINT                          Subresource,
+          D3D11_MAP                     MapType,
+          UINT                          MapFlags,
+          D3D11_MAPPED_SUBRESOURCE*     pMappedResource) final;
+  
+  void STDMETHODCALLTYPE Unmap(
+          ID3D11Resource*               pResource,
+          UINT                          Subresource) final;
+  
+  void STDMETHODCALLTYPE PSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE IASetInputLayout(
+          ID3D11InputLayout*            pInputLayout) final;
+  
+  void STDMETHODCALLTYPE IASetVertexBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppVertexBuffers,
+    const UINT*                         pStrides,
+    const UINT*                         pOffsets) final;
+  
+  void STDMETHODCALLTYPE IASetIndexBuffer(
+          ID3D11Buffer*                 pIndexBuffer,
+          DXGI_FORMAT                   Format,
+          UINT                          Offset) final;
+  
+  void STDMETHODCALLTYPE DrawIndexedInstanced(
+          UINT                          IndexCountPerInstance,
+          UINT                          InstanceCount,
+          UINT                          StartIndexLocation,
+          INT                           BaseVertexLocation,
+          UINT                          StartInstanceLocation) final;
+  
+  void STDMETHODCALLTYPE DrawInstanced(
+          UINT                          VertexCountPerInstance,
+          UINT                          InstanceCount,
+          UINT                          StartVertexLocation,
+          UINT                          StartInstanceLocation) final;
+  
+  void STDMETHODCALLTYPE GSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE GSSetShader(
+          ID3D11GeometryShader*         pShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE IASetPrimitiveTopology(
+          D3D11_PRIMITIVE_TOPOLOGY      Topology) final;
+  
+  void STDMETHODCALLTYPE VSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE VSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE Begin(
+          ID3D11Asynchronous*           pAsync) final;
+  
+  void STDMETHODCALLTYPE End(
+          ID3D11Asynchronous*           pAsync) final;
+  
+  HRESULT STDMETHODCALLTYPE GetData(
+          ID3D11Asynchronous*           pAsync,
+          void*                         pData,
+          UINT                          DataSize,
+          UINT                          GetDataFlags) final;
+  
+  void STDMETHODCALLTYPE SetPredication(
+          ID3D11Predicate*              pPredicate,
+          BOOL                          PredicateValue) final;
+  
+  void STDMETHODCALLTYPE GSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE GSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE OMSetRenderTargets(
+          UINT                          NumViews,
+          ID3D11RenderTargetView* const* ppRenderTargetViews,
+          ID3D11DepthStencilView*       pDepthStencilView) final;
+  
+  void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(
+          UINT                          NumRTVs,
+          ID3D11RenderTargetView* const* ppRenderTargetViews,
+          ID3D11DepthStencilView*       pDepthStencilView,
+          UINT                          UAVStartSlot,
+          UINT                          NumUAVs,
+          ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+    const UINT*                         pUAVInitialCounts) final;
+  
+  void STDMETHODCALLTYPE OMSetBlendState(
+          ID3D11BlendState*             pBlendState,
+    const FLOAT                         BlendFactor[4],
+          UINT                          SampleMask) final;
+  
+  void STDMETHODCALLTYPE OMSetDepthStencilState(
+          ID3D11DepthStencilState*      pDepthStencilState,
+          UINT                          StencilRef) final;
+  
+  void STDMETHODCALLTYPE SOSetTargets(
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppSOTargets,
+    const UINT*                         pOffsets) final;
+  
+  void STDMETHODCALLTYPE DrawAuto() final;
+  
+  void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(
+          ID3D11Buffer*                 pBufferForArgs,
+          UINT                          AlignedByteOffsetForArgs) final;
+  
+  void STDMETHODCALLTYPE DrawInstancedIndirect(
+          ID3D11Buffer*                 pBufferForArgs,
+          UINT                          AlignedByteOffsetForArgs) final;
+  
+  void STDMETHODCALLTYPE Dispatch(
+          UINT                          ThreadGroupCountX,
+          UINT                          ThreadGroupCountY,
+          UINT                          ThreadGroupCountZ) final;
+  
+  void STDMETHODCALLTYPE DispatchIndirect(
+          ID3D11Buffer*                 pBufferForArgs,
+          UINT                          AlignedByteOffsetForArgs) final;
+  
+  void STDMETHODCALLTYPE RSSetState(
+          ID3D11RasterizerState*        pRasterizerState) final;
+  
+  void STDMETHODCALLTYPE RSSetViewports(
+          UINT                          NumViewports,
+    const D3D11_VIEWPORT*               pViewports) final;
+  
+  void STDMETHODCALLTYPE RSSetScissorRects(
+          UINT                          NumRects,
+    const D3D11_RECT*                   pRects) final;
+  
+  void STDMETHODCALLTYPE CopySubresourceRegion(
+          ID3D11Resource*               pDstResource,
+          UINT                          DstSubresource,
+          UINT                          DstX,
+          UINT                          DstY,
+          UINT                          DstZ,
+          ID3D11Resource*               pSrcResource,
+          UINT                          SrcSubresource,
+    const D3D11_BOX*                    pSrcBox) final;
+  
+  void STDMETHODCALLTYPE CopyResource(
+          ID3D11Resource*               pDstResource,
+          ID3D11Resource*               pSrcResource) final;
+  
+  void STDMETHODCALLTYPE UpdateSubresource(
+          ID3D11Resource*               pDstResource,
+          UINT                          DstSubresource,
+    const D3D11_BOX*                    pDstBox,
+    const void*                         pSrcData,
+          UINT                          SrcRowPitch,
+          UINT                          SrcDepthPitch) final;
+  
+  void STDMETHODCALLTYPE CopyStructureCount(
+          ID3D11Buffer*                 pDstBuffer,
+          UINT                          DstAlignedByteOffset,
+          ID3D11UnorderedAccessView*    pSrcView) final;
+  
+  void STDMETHODCALLTYPE ClearRenderTargetView(
+          ID3D11RenderTargetView*       pRenderTargetView,
+    const FLOAT                         ColorRGBA[4]) final;
+  
+  void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(
+          ID3D11UnorderedAccessView*    pUnorderedAccessView,
+    const UINT                          Values[4]) final;
+  
+  void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(
+          ID3D11UnorderedAccessView*    pUnorderedAccessView,
+    const FLOAT                         Values[4]) final;
+  
+  void STDMETHODCALLTYPE ClearDepthStencilView(
+          ID3D11DepthStencilView*       pDepthStencilView,
+          UINT                          ClearFlags,
+          FLOAT                         Depth,
+          UINT8                         Stencil) final;
+  
+  void STDMETHODCALLTYPE GenerateMips(
+          ID3D11ShaderResourceView*     pShaderResourceView) final;
+  
+  void STDMETHODCALLTYPE SetResourceMinLOD(
+          ID3D11Resource*               pResource,
+          FLOAT                         MinLOD) final;
+  
+  FLOAT STDMETHODCALLTYPE GetResourceMinLOD(
+          ID3D11Resource*               pResource) final;
+  
+  void STDMETHODCALLTYPE ResolveSubresource(
+          ID3D11Resource*               pDstResource,
+          UINT                          DstSubresource,
+          ID3D11Resource*               pSrcResource,
+          UINT                          SrcSubresource,
+          DXGI_FORMAT                   Format) final;
+  
+  void STDMETHODCALLTYPE ExecuteCommandList(
+          ID3D11CommandList*            pCommandList,
+          BOOL                          RestoreContextState) final;
+  
+  void STDMETHODCALLTYPE HSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE HSSetShader(
+          ID3D11HullShader*             pHullShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE HSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE HSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE DSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE DSSetShader(
+          ID3D11DomainShader*           pDomainShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE DSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE DSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE CSSetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView* const* ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE CSSetUnorderedAccessViews(
+          UINT                          StartSlot,
+          UINT                          NumUAVs,
+          ID3D11UnorderedAccessView* const* ppUnorderedAccessViews,
+    const UINT*                         pUAVInitialCounts) final;
+  
+  void STDMETHODCALLTYPE CSSetShader(
+          ID3D11ComputeShader*          pComputeShader,
+          ID3D11ClassInstance* const*   ppClassInstances,
+          UINT                          NumClassInstances) final;
+  
+  void STDMETHODCALLTYPE CSSetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState* const*    ppSamplers) final;
+  
+  void STDMETHODCALLTYPE CSSetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE VSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE PSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE PSGetShader(
+          ID3D11PixelShader**           ppPixelShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE PSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE VSGetShader(
+          ID3D11VertexShader**          ppVertexShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE PSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE IAGetInputLayout(
+          ID3D11InputLayout**           ppInputLayout) final;
+  
+  void STDMETHODCALLTYPE IAGetVertexBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppVertexBuffers,
+          UINT*                         pStrides,
+          UINT*                         pOffsets) final;
+  
+  void STDMETHODCALLTYPE IAGetIndexBuffer(
+          ID3D11Buffer**                ppIndexBuffer,
+          DXGI_FORMAT*                  pFormat,
+          UINT*                         pOffset) final;
+  
+  void STDMETHODCALLTYPE GSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE GSGetShader(
+          ID3D11GeometryShader**        ppGeometryShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE IAGetPrimitiveTopology(
+          D3D11_PRIMITIVE_TOPOLOGY*     pTopology) final;
+  
+  void STDMETHODCALLTYPE VSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE VSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE GetPredication(
+          ID3D11Predicate**             ppPredicate,
+          BOOL*                         pPredicateValue) final;
+  
+  void STDMETHODCALLTYPE GSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE GSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE OMGetRenderTargets(
+          UINT                          NumViews,
+          ID3D11RenderTargetView**      ppRenderTargetViews,
+          ID3D11DepthStencilView**      ppDepthStencilView) final;
+  
+  void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(
+          UINT                          NumRTVs,
+          ID3D11RenderTargetView**      ppRenderTargetViews,
+          ID3D11DepthStencilView**      ppDepthStencilView,
+          UINT                          UAVStartSlot,
+          UINT                          NumUAVs,
+          ID3D11UnorderedAccessView**   ppUnorderedAccessViews) final;
+  
+  void STDMETHODCALLTYPE OMGetBlendState(
+          ID3D11BlendState**            ppBlendState,
+          FLOAT                         BlendFactor[4],
+          UINT*                         pSampleMask) final;
+  
+  void STDMETHODCALLTYPE OMGetDepthStencilState(
+          ID3D11DepthStencilState**     ppDepthStencilState,
+          UINT*                         pStencilRef) final;
+  
+  void STDMETHODCALLTYPE SOGetTargets(
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppSOTargets) final;
+  
+  void STDMETHODCALLTYPE RSGetState(
+          ID3D11RasterizerState**       ppRasterizerState) final;
+  
+  void STDMETHODCALLTYPE RSGetViewports(
+          UINT*                         pNumViewports,
+          D3D11_VIEWPORT*               pViewports) final;
+  
+  void STDMETHODCALLTYPE RSGetScissorRects(
+          UINT*                         pNumRects,
+          D3D11_RECT*                   pRects) final;
+  
+  void STDMETHODCALLTYPE HSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE HSGetShader(
+          ID3D11HullShader**            ppHullShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE HSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE HSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE DSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE DSGetShader(
+          ID3D11DomainShader**          ppDomainShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE DSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE DSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE CSGetShaderResources(
+          UINT                          StartSlot,
+          UINT                          NumViews,
+          ID3D11ShaderResourceView**    ppShaderResourceViews) final;
+  
+  void STDMETHODCALLTYPE CSGetUnorderedAccessViews(
+          UINT                          StartSlot,
+          UINT                          NumUAVs,
+          ID3D11UnorderedAccessView**   ppUnorderedAccessViews) final;
+  
+  void STDMETHODCALLTYPE CSGetShader(
+          ID3D11ComputeShader**         ppComputeShader,
+          ID3D11ClassInstance**         ppClassInstances,
+          UINT*                         pNumClassInstances) final;
+  
+  void STDMETHODCALLTYPE CSGetSamplers(
+          UINT                          StartSlot,
+          UINT                          NumSamplers,
+          ID3D11SamplerState**          ppSamplers) final;
+  
+  void STDMETHODCALLTYPE CSGetConstantBuffers(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers) final;
+  
+  void STDMETHODCALLTYPE ClearState() final;
+  
+  void STDMETHODCALLTYPE Flush() final;
+  
+  D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() final;
+  
+  UINT STDMETHODCALLTYPE GetContextFlags() final;
+  
+  HRESULT STDMETHODCALLTYPE FinishCommandList(
+          BOOL                          RestoreDeferredContextState,
+          ID3D11CommandList**           ppCommandList) final;
+  
+  void STDMETHODCALLTYPE CopySubresourceRegion1(
+          ID3D11Resource*               pDstResource,
+          UINT                          DstSubresource,
+          UINT                          DstX,
+          UINT                          DstY,
+          UINT                          DstZ,
+          ID3D11Resource*               pSrcResource,
+          UINT                          SrcSubresource,
+    const D3D11_BOX*                    pSrcBox,
+          UINT                          CopyFlags) final;
+  
+  void STDMETHODCALLTYPE UpdateSubresource1(
+          ID3D11Resource*               pDstResource,
+          UINT                          DstSubresource,
+    const D3D11_BOX*                    pDstBox,
+    const void*                         pSrcData,
+          UINT                          SrcRowPitch,
+          UINT                          SrcDepthPitch,
+          UINT                          CopyFlags) final;
+  
+  void STDMETHODCALLTYPE DiscardResource(
+          ID3D11Resource*               pResource) final;
+  
+  void STDMETHODCALLTYPE DiscardView(
+          ID3D11View*                   pResourceView) final;
+  
+  void STDMETHODCALLTYPE VSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE HSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE DSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE GSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE PSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE CSSetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer* const*          ppConstantBuffers,
+    const UINT*                         pFirstConstant,
+    const UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE VSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE HSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE DSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE GSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE PSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE CSGetConstantBuffers1(
+          UINT                          StartSlot,
+          UINT                          NumBuffers,
+          ID3D11Buffer**                ppConstantBuffers,
+          UINT*                         pFirstConstant,
+          UINT*                         pNumConstants) final;
+  
+  void STDMETHODCALLTYPE SwapDeviceContextState(
+          ID3DDeviceContextState*       pState,
+          ID3DDeviceContextState**      ppPreviousState) final;
+  
+  void STDMETHODCALLTYPE ClearView(
+          ID3D11View*                   pView,
+    const FLOAT                         Color[4],
+    const D3D11_RECT*                   pRect,
+          UINT                          NumRects) final;
+  
+  void STDMETHODCALLTYPE DiscardView1(
+          ID3D11View*                   pResourceView,
+    const D3D11_RECT*                   pRects,
+          UINT                          NumRects) final;
+  
+  HRESULT STDMETHODCALLTYPE UpdateTileMappings(
+          ID3D11Resource*               pTiledResource,
+          UINT                          NumTiledResourceRegions,
+    const D3D11_TILED_RESOURCE_COORDINATE* pTiledResourceRegionStartCoordinates,
+    const D3D11_TILE_REGION_SIZE*       pTiledResourceRegionSizes,
+          ID3D11Buffer*                 pTilePool,
+          UINT                          NumRanges,
+    const UINT*                         pRangeFlags,
+    const UINT*                         pTilePoolStartOffsets,
+    const UINT*                         pRangeTileCounts,
+          UINT                          Flags) final;
+  
+  HRESULT STDMETHODCALLTYPE CopyTileMappings(
+          ID3D11Resource*               pDestTiledResource,
+    const D3D11_TILED_RESOURCE_COORDINATE* pDestRegionStartCoordinate,
+          ID3D11Resource*               pSourceTiledResource,
+    const D3D11_TILED_RESOURCE_COORDINATE* pSourceRegionStartCoordinate,
+    const D3D11_TILE_REGION_SIZE*       pTileRegionSize,
+          UINT                          Flags) final;
+  
+  void STDMETHODCALLTYPE CopyTiles(
+          ID3D11Resource*               pTiledResource,
+    const D3D11_TILED_RESOURCE_COORDINATE* pTileRegionStartCoordinate,
+    const D3D11_TILE_REGION_SIZE*       pTileRegionSize,
+          ID3D11Buffer*                 pBuffer,
+          UINT64                        BufferStartOffsetInBytes,
+          UINT                          Flags) final;
+  
+  void STDMETHODCALLTYPE UpdateTiles(
+          ID3D11Resource*               pDestTiledResource,
+    const D3D11_TILED_RESOURCE_COORDINATE* pDestTileRegionStartCoordinate,
+    const D3D11_TILE_REGION_SIZE*       pDestTileRegionSize,
+    const void*                         pSourceTileData,
+          UINT                          Flags) final;
+  
+  HRESULT STDMETHODCALLTYPE ResizeTilePool(
+          ID3D11Buffer*                 pTilePool,
+          UINT64                        NewSizeInBytes) final;
+  
+  void STDMETHODCALLTYPE TiledResourceBarrier(
+          ID3D11DeviceChild*            pTiledResourceOrViewAccessBeforeBarrier,
+          ID3D11DeviceChild*            pTiledResourceOrViewAccessAfterBarrier) final;
+  
+  BOOL STDMETHODCALLTYPE IsAnnotationEnabled() final;
+  
+  void STDMETHODCALLTYPE SetMarkerInt(
+          LPCWSTR                       pLabel,
+          INT                           Data) final;
+  
+  void STDMETHODCALLTYPE BeginEventInt(
+          LPCWSTR                       pLabel,
+          INT                           Data) final;
+  
+  void STDMETHODCALLTYPE EndEvent() final;
+  
+  void STDMETHODCALLTYPE Flush1(
+          D3D11_CONTEXT_TYPE            ContextType,
+          HANDLE                        hEvent) final;
+  
+  void STDMETHODCALLTYPE SetHardwareProtectionState(
+          BOOL                          HwProtectionEnable) final;
+  
+  void STDMETHODCALLTYPE GetHardwareProtectionState(
+          BOOL*                         pHwProtectionEnable) final;
+  
+  HRESULT STDMETHODCALLTYPE Signal(
+          ID3D11Fence*                  pFence,
+          UINT64                        Value) final;
+  
+  HRESULT STDMETHODCALLTYPE Wait(
+          ID3D11Fence*                  pFence,
+          UINT64                        Value) final;
+
+private:
+
+  std::atomic<ULONG>    m_refCount = { 1u };
+  
+  AGSContext*           m_context;
+  ID3D11DeviceContext4* m_ctx;
+  
+  // Draw count buffers that are currently mapped
+  // for writing, along with the mapped pointer
+  std::vector<std::pair<ID3D11Resource*, const void*>> m_mappedDrawCounts;
+
+};
+
+
+/**
+ * \brief Swap chain wrapper
+ * 
+ * Forwards all calls to the wrapped swap chain and
+ * invokes the frame boundary hook on present. Games
+ * commonly present through \c IDXGISwapChain3, and HDR
+ * games through \c IDXGISwapChain4, so we need to
+ * implement those in order to see frames.
+ */
+class AgsSwapChain final : public IDXGISwapChain4 {
+
+public:
+
+  AgsSwapChain(
+          AGSContext*                   context,
+          IDXGISwapChain4*              swapChain);
+  
+  ~AgsSwapChain();
+  
+  HRESULT STDMETHODCALLTYPE QueryInterface(
+          REFIID                        riid,
+          void**                        ppvObject) final;
+  
+  ULONG STDMETHODCALLTYPE AddRef() final;
+  
+  ULONG STDMETHODCALLTYPE Release() final;
+  
+  HRESULT STDMETHODCALLTYPE Present(
+          UINT                          SyncInterval,
+          UINT                          Flags) final;
+  
+  HRESULT STDMETHODCALLTYPE Present1(
+          UINT                          SyncInterval,
+          UINT                          PresentFlags,
+    const DXGI_PRESENT_PARAMETERS*      pPresentParameters) final;
+  
+  HRESULT STDMETHODCALLTYPE SetPrivateData(
+          REFGUID                       Name,
+          UINT                          DataSize,
+    const void*                         pData) final;
+  
+  HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(
+          REFGUID                       Name,
+    const IUnknown*                     pUnknown) final;
+  
+  HRESULT STDMETHODCALLTYPE GetPrivateData(
+          REFGUID                       Name,
+          UINT*                         pDataSize,
+          void*                         pData) final;
+  
+  HRESULT STDMETHODCALLTYPE GetParent(
+          REFIID                        riid,
+          void**                        ppParent) final;
+  
+  HRESULT STDMETHODCALLTYPE GetDevice(
+          REFIID                        riid,
+          void**                        ppDevice) final;
+  
+  HRESULT STDMETHODCALLTYPE GetBuffer(
+          UINT                          Buffer,
+          REFIID                        riid,
+          void**                        ppSurface) final;
+  
+  HRESULT STDMETHODCALLTYPE SetFullscreenState(
+          BOOL                          Fullscreen,
+          IDXGIOutput*                  pTarget) final;
+  
+  HRESULT STDMETHODCALLTYPE GetFullscreenState(
+          BOOL*                         pFullscreen,
+          IDXGIOutput**                 ppTarget) final;
+  
+  HRESULT STDMETHODCALLTYPE GetDesc(
+          DXGI_SWAP_CHAIN_DESC*         pDesc) final;
+  
+  HRESULT STDMETHODCALLTYPE ResizeBuffers(
+          UINT                          BufferCount,
+          UINT                          Width,
+          UINT                          Height,
+          DXGI_FORMAT                   NewFormat,
+          UINT                          SwapChainFlags) final;
+  
+  HRESULT STDMETHODCALLTYPE ResizeTarget(
+    const DXGI_MODE_DESC*               pNewTargetParameters) final;
+  
+  HRESULT STDMETHODCALLTYPE GetContainingOutput(
+          IDXGIOutput**                 ppOutput) final;
+  
+  HRESULT STDMETHODCALLTYPE GetFrameStatistics(
+          DXGI_FRAME_STATISTICS*        pStats) final;
+  
+  HRESULT STDMETHODCALLTYPE GetLastPresentCount(
+          UINT*                         pLastPresentCount) final;
+  
+  HRESULT STDMETHODCALLTYPE GetDesc1(
+          DXGI_SWAP_CHAIN_DESC1*        pDesc) final;
+  
+  HRESULT STDMETHODCALLTYPE GetFullscreenDesc(
+          DXGI_SWAP_CHAIN_FULLSCREEN_DESC* pDesc) final;
+  
+  HRESULT STDMETHODCALLTYPE GetHwnd(
+          HWND*                         pHwnd) final;
+  
+  HRESULT STDMETHODCALLTYPE GetCoreWindow(
+          REFIID                        riid,
+          void**                        ppUnk) final;
+  
+  BOOL STDMETHODCALLTYPE IsTemporaryMonoSupported() final;
+  
+  HRESULT STDMETHODCALLTYPE GetRestrictToOutput(
+          IDXGIOutput**                 ppRestrictToOutput) final;
+  
+  HRESULT STDMETHODCALLTYPE SetBackgroundColor(
+    const DXGI_RGBA*                    pColor) final;
+  
+  HRESULT STDMETHODCALLTYPE GetBackgroundColor(
+          DXGI_RGBA*                    pColor) final;
+  
+  HRESULT STDMETHODCALLTYPE SetRotation(
+          DXGI_MODE_ROTATION            Rotation) final;
+  
+  HRESULT STDMETHODCALLTYPE GetRotation(
+          DXGI_MODE_ROTATION*           pRotation) final;
+  
+  HRESULT STDMETHODCALLTYPE SetSourceSize(
+          UINT                          Width,
+          UINT                          Height) final;
+  
+  HRESULT STDMETHODCALLTYPE GetSourceSize(
+          UINT*                         pWidth,
+          UINT*                         pHeight) final;
+  
+  HRESULT STDMETHODCALLTYPE SetMaximumFrameLatency(
+          UINT                          MaxLatency) final;
+  
+  HRESULT STDMETHODCALLTYPE GetMaximumFrameLatency(
+          UINT*                         pMaxLatency) final;
+  
+  HANDLE STDMETHODCALLTYPE GetFrameLatencyWaitableObject() final;
+  
+  HRESULT STDMETHODCALLTYPE SetMatrixTransform(
+    const DXGI_MATRIX_3X2_F*            pMatrix) final;
+  
+  HRESULT STDMETHODCALLTYPE GetMatrixTransform(
+          DXGI_MATRIX_3X2_F*            pMatrix) final;
+  
+  UINT STDMETHODCALLTYPE GetCurrentBackBufferIndex() final;
+  
+  HRESULT STDMETHODCALLTYPE CheckColorSpaceSupport(
+          DXGI_COLOR_SPACE_TYPE         ColorSpace,
+          UINT*                         pColorSpaceSupport) final;
+  
+  HRESULT STDMETHODCALLTYPE SetColorSpace1(
+          DXGI_COLOR_SPACE_TYPE         ColorSpace) final;
+  
+  HRESULT STDMETHODCALLTYPE ResizeBuffers1(
+          UINT                          BufferCount,
+          UINT                          Width,
+          UINT                          Height,
+          DXGI_FORMAT                   Format,
+          UINT                          SwapChainFlags,
+    const UINT*                         pCreationNodeMask,
+          IUnknown* const*              ppPresentQueue) final;
+  
+  HRESULT STDMETHODCALLTYPE SetHDRMetaData(
+          DXGI_HDR_METADATA_TYPE        Type,
+          UINT                          Size,
+          void*                         pMetaData) final;
+
+private:
+
+  std::atomic<ULONG>    m_refCount = { 1u };
+  
+  AGSContext*           m_context;
+  IDXGISwapChain4*      m_swapChain;
+
+};
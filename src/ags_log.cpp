@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cstring>
+
+#include <windows.h>
+
+#include "ags_log.h"
+
+AGSLog::~AGSLog() {
+  m_data[m_size++] = '\n';
+  
+  DWORD written = 0;
+  WriteFile(GetStdHandle(STD_ERROR_HANDLE), m_data, DWORD(m_size), &written, nullptr);
+}
+
+
+AGSLog& AGSLog::operator << (const char* str) {
+  str = str ? str : "(null)";
+  append(str, std::strlen(str));
+  return *this;
+}
+
+
+AGSLog& AGSLog::operator << (const std::string& str) {
+  append(str.data(), str.size());
+  return *this;
+}
+
+
+AGSLog& AGSLog::operator << (const void* ptr) {
+  append("0x", 2);
+  appendUint(uint64_t(reinterpret_cast<uintptr_t>(ptr)), 16);
+  return *this;
+}
+
+
+AGSLog& AGSLog::operator << (AGSLogHex hex) {
+  appendUint(hex.value, 16);
+  return *this;
+}
+
+
+void AGSLog::append(
+  const char*                         str,
+        size_t                        length) {
+  // Always leave room for the line break
+  length = std::min(length, sizeof(m_data) - 1 - m_size);
+  
+  std::memcpy(&m_data[m_size], str, length);
+  m_size += length;
+}
+
+
+void AGSLog::appendInt(
+        int64_t                       value) {
+  if (value < 0) {
+    append("-", 1);
+    appendUint(0ull - uint64_t(value), 10);
+  } else {
+    appendUint(uint64_t(value), 10);
+  }
+}
+
+
+void AGSLog::appendUint(
+        uint64_t                      value,
+        uint32_t                      base) {
+  char digits[20];
+  size_t count = 0;
+  
+  do {
+    digits[sizeof(digits) - ++count] = "0123456789abcdef"[value % base];
+    value /= base;
+  } while (value);
+  
+  append(&digits[sizeof(digits) - count], count);
+}
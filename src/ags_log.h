@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * \brief Hexadecimal log value
+ */
+struct AGSLogHex {
+  uint64_t value;
+};
+
+/**
+ * \brief Log line
+ * 
+ * Lightweight replacement for \c std::cerr, which
+ * would pull in static constructors that run when the
+ * DLL gets loaded. Formats into a fixed-size buffer
+ * and writes the line to \c stderr in one go when the
+ * object is destroyed, so that lines written by
+ * different threads do not get mixed up.
+ */
+class AGSLog {
+
+public:
+
+  AGSLog() = default;
+  
+  AGSLog             (const AGSLog&) = delete;
+  AGSLog& operator = (const AGSLog&) = delete;
+  
+  ~AGSLog();
+  
+  AGSLog& operator << (const char* str);
+  
+  AGSLog& operator << (const std::string& str);
+  
+  AGSLog& operator << (const void* ptr);
+  
+  AGSLog& operator << (AGSLogHex hex);
+  
+  template<typename T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
+  AGSLog& operator << (T value) {
+    if constexpr (std::is_enum_v<T>)
+      return *this << std::underlying_type_t<T>(value);
+    else if constexpr (std::is_signed_v<T>)
+      appendInt(int64_t(value));
+    else
+      appendUint(uint64_t(value), 10);
+    return *this;
+  }
+
+private:
+
+  char    m_data[1024];
+  size_t  m_size = 0;
+  
+  void append(const char* str, size_t length);
+  
+  void appendInt(int64_t value);
+  
+  void appendUint(uint64_t value, uint32_t base);
+
+};
+
+
+/**
+ * \brief Begins a log line
+ * \returns Log line, written at the end of the statement
+ */
+inline AGSLog agsLog() {
+  return AGSLog();
+}
+
+
+inline AGSLogHex agsLogHex(
+        uint64_t                      value) {
+  return AGSLogHex { value };
+}
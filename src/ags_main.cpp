@@ -1,24 +1,79 @@
 #include "ags_private.h"
+#include "ags_drawcount.h"
+#include "ags_emulation.h"
+#include "ags_profile.h"
+#include "ags_stats.h"
+#include "ags_timing.h"
 
-extern "C" {
+typedef HRESULT (WINAPI *PFN_CREATE_DXGI_FACTORY1)(REFIID, void**);
+
+static PFN_CREATE_DXGI_FACTORY1 agsGetCreateFactoryProc() {
+  // Resolve this at runtime instead of importing it, so
+  // that loading the DLL does not pull in dxgi.dll. The
+  // module is never freed since the factory lives on.
+  HMODULE module = LoadLibraryA("dxgi.dll");
   
-AMD_AGS_API AGSReturnCode __stdcall agsInit(
+  if (!module)
+    return nullptr;
+  
+  return reinterpret_cast<PFN_CREATE_DXGI_FACTORY1>(
+    GetProcAddress(module, "CreateDXGIFactory1"));
+}
+
+
+static AGSReturnCode agsCreateContext(
         AGSContext**                  context,
   const AGSConfiguration*             config,
         AGSGPUInfo*                   gpuInfo) {
-  std::cerr << "agsInit(" << context << "," << config << "," << gpuInfo << ")" << std::endl;
   if (!context)
     return AGS_INVALID_ARGS;
   
   IDXGIFactory1* dxgiFactory;
   
-  if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory))))
+  PFN_CREATE_DXGI_FACTORY1 createFactory = agsGetCreateFactoryProc();
+  
+  if (!createFactory || FAILED(createFactory(IID_PPV_ARGS(&dxgiFactory))))
     return AGS_FAILURE;
   
   *context = new AGSContext();
   (*context)->dxgiFactory  = dxgiFactory;
+  (*context)->d3d11Module  = nullptr;
   (*context)->dxvkDevice   = nullptr;
   (*context)->dxvkContext  = nullptr;
+  (*context)->dxvkDevice1  = nullptr;
+  (*context)->dxvkContext1 = nullptr;
+  (*context)->d3d12Module  = nullptr;
+  (*context)->d3d12Device  = nullptr;
+  (*context)->vkd3dDevice  = nullptr;
+  (*context)->d3d12IntrinsicUavSlot = 0;
+  (*context)->d3d12IntrinsicExtensions = 0;
+  (*context)->d3d12IntrinsicOpcodes = 0;
+  (*context)->userMarkersEnabled = false;
+  (*context)->d3d12AppRegistered = false;
+  (*context)->appRegistered = false;
+  (*context)->diskShaderCacheEnabled = true;
+  
+  (*context)->gpuTiming    = nullptr;
+  (*context)->drawCountTracker = nullptr;
+  (*context)->emulation    = nullptr;
+  
+  agsProfileLoad(*context);
+  
+  (*context)->frameId          = 0;
+  (*context)->frameStartTicks  = 0;
+  (*context)->depthBoundsEnabled = false;
+  (*context)->killSwitches     = 0;
+  (*context)->extensionsSupported = 0;
+  (*context)->mdiDraws         = 0;
+  (*context)->maxDrawIndirectCount = ~0u;
+  (*context)->drawCountShadowing = false;
+  (*context)->drawCountEpoch   = 0;
+  (*context)->placementHints   = false;
+  
+  if ((*context)->telemetryEnabled)
+    agsStatsInitTelemetry(*context);
+  else
+    (*context)->telemetry = nullptr;
   
   IDXGIAdapter* dxgiAdapter;
   
@@ -29,7 +84,13 @@ AMD_AGS_API AGSReturnCode __stdcall agsInit(
     
     AGSDeviceInfo info = { };
     info.adapterString        = "Device";
+    #if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+    info.asicFamily           = AsicFamily_GCN4;
+    #elif BUILD_VERSION >= AGS_MAKE_VERSION(5, 4, 0)
+    info.asicFamily           = AGSDeviceInfo::AsicFamily_GCN4;
+    #else
     info.architectureVersion  = AGSDeviceInfo::ArchitectureVersion_GCN;
+    #endif
     info.vendorId             = desc.VendorId;
     info.deviceId             = desc.DeviceId;
     info.revisionId           = desc.Revision;
@@ -41,39 +102,140 @@ AMD_AGS_API AGSReturnCode __stdcall agsInit(
   }
   
   if (gpuInfo) {
+    #if BUILD_VERSION < AGS_MAKE_VERSION(6, 0, 0)
     gpuInfo->agsVersionMajor  = AMD_AGS_VERSION_MAJOR;
     gpuInfo->agsVersionMinor  = AMD_AGS_VERSION_MINOR;
     gpuInfo->agsVersionPatch  = AMD_AGS_VERSION_PATCH;
     gpuInfo->isWACKCompliant  = 0;
+    #endif
     gpuInfo->driverVersion    = "bla";
     gpuInfo->radeonSoftwareVersion = "bla";
     gpuInfo->numDevices       = (*context)->deviceInfo.size();
     gpuInfo->devices          = (*context)->deviceInfo.data();
   }
   
-  std::cerr << "agsInit() = AGS_SUCCESS" << std::endl;
   return AGS_SUCCESS;
 }
 
 
-AMD_AGS_API AGSReturnCode __stdcall agsDeInit(
+static AGSReturnCode agsDestroyContext(
         AGSContext*                   context) {
-  std::cerr << "agsDeInit(" << context << ")" << std::endl;
-  
   if (!context)
     return AGS_INVALID_ARGS;
   
   if (context->dxvkDevice) {
+    agsTimingDestroy(context);
+    agsDrawCountDestroy(context);
+    agsEmulationDestroy(context);
+    
+    if (context->dxvkDevice1) {
+      context->dxvkDevice1->Release();
+      context->dxvkContext1->Release();
+    }
+    
     context->dxvkDevice->Release();
     context->dxvkContext->Release();
   }
   
+  // Keep d3d12.dll loaded if the app leaked the device
+  if (context->d3d12Module && !context->d3d12Device)
+    FreeLibrary(context->d3d12Module);
+  
   context->dxgiFactory->Release();
-  std::cerr << "agsDeInit() = AGS_SUCCESS" << std::endl;
+  
+  const AGSAfrStats& afr = context->afrStats;
+  
+  if (afr.resourcesCreated.load() || afr.notifyEndWrites.load()
+   || afr.notifyBeginAllAccess.load() || afr.notifyEndAllAccess.load()) {
+    agsLog() << "AFR resources: " << afr.resourcesCreated.load()
+             << " created, " << afr.resourcesWithHints.load() << " with transfer hints";
+    agsLog() << "AFR notifications: " << afr.notifyEndWrites.load() << " end writes, "
+             << afr.notifyBeginAllAccess.load() << " begin all access, "
+             << afr.notifyEndAllAccess.load() << " end all access";
+  }
+  
+  const AGSMdiShapingStats& mdi = context->mdiShaping;
+  
+  if (mdi.callsElided.load() || mdi.callsDemoted.load()
+   || mdi.callsSplit.load() || mdi.callsClamped.load()
+   || mdi.callsEmulated.load() || mdi.callsResolved.load()) {
+    agsLog() << "MDI calls: " << mdi.callsElided.load() << " elided, "
+             << mdi.callsDemoted.load() << " demoted to single draws, "
+             << mdi.callsSplit.load() << " split, "
+             << mdi.callsClamped.load() << " count calls clamped, "
+             << mdi.callsEmulated.load() << " emulated, "
+             << mdi.callsResolved.load() << " count calls with CPU-known count";
+  }
+  
+  agsStatsLogFrames(context);
+  agsStatsDestroyTelemetry(context);
   return AGS_SUCCESS;
 }
 
 
+extern "C" {
+
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+AMD_AGS_API AGSReturnCode __stdcall agsInitialize(
+        int                           agsVersion,
+  const AGSConfiguration*             config,
+        AGSContext**                  context,
+        AGSGPUInfo*                   gpuInfo) {
+  agsLog() << "agsInitialize(" << agsLogHex(agsVersion) << ","
+           << config << "," << context << "," << gpuInfo << ")";
+  
+  // Struct layouts only change between major versions,
+  // so accept any 6.x header instead of failing hard
+  if ((unsigned int)(agsVersion) >> 22 != AMD_AGS_VERSION_MAJOR) {
+    agsLog() << "agsInitialize: Unsupported AGS version";
+    return AGS_INVALID_ARGS;
+  }
+  
+  AGSReturnCode ar = agsCreateContext(context, config, gpuInfo);
+  
+  if (ar == AGS_SUCCESS)
+    agsLog() << "agsInitialize() = AGS_SUCCESS";
+  
+  return ar;
+}
+
+
+AMD_AGS_API AGSReturnCode __stdcall agsDeInitialize(
+        AGSContext*                   context) {
+  agsLog() << "agsDeInitialize(" << context << ")";
+  return agsDestroyContext(context);
+}
+#else
+AMD_AGS_API AGSReturnCode __stdcall agsInit(
+        AGSContext**                  context,
+  const AGSConfiguration*             config,
+        AGSGPUInfo*                   gpuInfo) {
+  agsLog() << "agsInit(" << context << "," << config << "," << gpuInfo << ")";
+  
+  AGSReturnCode ar = agsCreateContext(context, config, gpuInfo);
+  
+  if (ar == AGS_SUCCESS)
+    agsLog() << "agsInit() = AGS_SUCCESS";
+  
+  return ar;
+}
+
+
+AMD_AGS_API AGSReturnCode __stdcall agsDeInit(
+        AGSContext*                   context) {
+  agsLog() << "agsDeInit(" << context << ")";
+  return agsDestroyContext(context);
+}
+#endif
+
+
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+AMD_AGS_API int __stdcall agsGetVersionNumber() {
+  return BUILD_VERSION;
+}
+#endif
+
+
 #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
 AMD_AGS_API AGSDriverVersionResult __stdcall agsCheckDriverVersion(
   const char*                         radeonSoftwareVersionReported,
@@ -91,7 +253,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsGetCrossfireGPUCount(
         int*                          numGPUs) {
   if (!numGPUs || !context)
     return AGS_INVALID_ARGS;
-
+  
   *numGPUs = 1;
   return AGS_SUCCESS;
 }
@@ -103,7 +265,7 @@ AMD_AGS_API AGSReturnCode __stdcall agsSetDisplayMode(
         int                           deviceIndex,
         int                           displayIndex,
   const AGSDisplaySettings*           settings) {
-  std::cerr << "agsSetDisplayMode: Not implemented" << std::endl;
+  agsLog() << "agsSetDisplayMode: Not implemented";
   return AGS_ERROR_LEGACY_DRIVER;
 }
 
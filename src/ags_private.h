@@ -2,12 +2,18 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 
-#include <d3d11_1.h>
-#include <dxgi1_4.h>
+#include <d3d11_4.h>
+#include <dxgi1_5.h>
 
+#include <algorithm>
 #include <array>
-#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -16,7 +22,12 @@
 // Change to build different version
 #include AGS_INCLUDE_HEADER
 
+#include "./ags_log.h"
+#include "./ags_telemetry.h"
+
+#include "./dxbc/dxbc_intrinsics.h"
 #include "./dxvk/dxvk_interfaces.h"
+#include "./vkd3d/vkd3d_interfaces.h"
 
 // AGS 5.0 headers don#t define this
 #ifndef AGS_MAKE_VERSION
@@ -26,10 +37,286 @@
 #define BUILD_VERSION \
   AGS_MAKE_VERSION(AMD_AGS_VERSION_MAJOR, AMD_AGS_VERSION_MINOR, AMD_AGS_VERSION_PATCH)
 
+// AGS 5.0 and 5.1 use a different name for med3
+#if BUILD_VERSION < AGS_MAKE_VERSION(5, 2, 0)
+#define AGS_DX11_EXTENSION_INTRINSIC_MED3 AGS_DX11_EXTENSION_INTRINSIC_COMPARE3
+#define AGS_DX12_EXTENSION_INTRINSIC_MED3 AGS_DX12_EXTENSION_INTRINSIC_COMPARE3
+#endif
+
+// AGS 6 drops the ERROR_ prefix from some return codes
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+#define AGS_ERROR_LEGACY_DRIVER AGS_LEGACY_DRIVER
+#endif
+
+// AGS 6 reports extensions as bitfields. We keep using the
+// AGS 5 bit masks internally, and for profiles and telemetry,
+// and only convert them when returning them to the game.
+#if BUILD_VERSION >= AGS_MAKE_VERSION(6, 0, 0)
+enum AGSDriverExtensionDX11 {
+  AGS_DX11_EXTENSION_QUADLIST                         = 1 << 0,
+  AGS_DX11_EXTENSION_SCREENRECTLIST                   = 1 << 1,
+  AGS_DX11_EXTENSION_UAV_OVERLAP                      = 1 << 2,
+  AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST                = 1 << 3,
+  AGS_DX11_EXTENSION_MULTIDRAWINDIRECT                = 1 << 4,
+  AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT  = 1 << 5,
+  AGS_DX11_EXTENSION_CROSSFIRE_API                    = 1 << 6,
+  AGS_DX11_EXTENSION_INTRINSIC_READFIRSTLANE          = 1 << 7,
+  AGS_DX11_EXTENSION_INTRINSIC_READLANE               = 1 << 8,
+  AGS_DX11_EXTENSION_INTRINSIC_LANEID                 = 1 << 9,
+  AGS_DX11_EXTENSION_INTRINSIC_SWIZZLE                = 1 << 10,
+  AGS_DX11_EXTENSION_INTRINSIC_BALLOT                 = 1 << 11,
+  AGS_DX11_EXTENSION_INTRINSIC_MBCOUNT                = 1 << 12,
+  AGS_DX11_EXTENSION_INTRINSIC_MED3                   = 1 << 13,
+  AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS           = 1 << 14,
+  AGS_DX11_EXTENSION_INTRINSIC_WAVE_REDUCE            = 1 << 15,
+  AGS_DX11_EXTENSION_INTRINSIC_WAVE_SCAN              = 1 << 16,
+  AGS_DX11_EXTENSION_CREATE_SHADER_CONTROLS           = 1 << 17,
+  AGS_DX11_EXTENSION_MULTIVIEW                        = 1 << 18,
+  AGS_DX11_EXTENSION_APP_REGISTRATION                 = 1 << 19,
+  AGS_DX11_EXTENSION_BREADCRUMB_MARKERS               = 1 << 20,
+  AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS            = 1 << 21,
+  AGS_DX11_EXTENSION_UAV_OVERLAP_DEFERRED_CONTEXTS    = 1 << 22,
+  AGS_DX11_EXTENSION_DEPTH_BOUNDS_DEFERRED_CONTEXTS   = 1 << 23,
+};
+
+enum AGSDriverExtensionDX12 {
+  AGS_DX12_EXTENSION_INTRINSIC_READFIRSTLANE          = 1 << 0,
+  AGS_DX12_EXTENSION_INTRINSIC_READLANE               = 1 << 1,
+  AGS_DX12_EXTENSION_INTRINSIC_LANEID                 = 1 << 2,
+  AGS_DX12_EXTENSION_INTRINSIC_SWIZZLE                = 1 << 3,
+  AGS_DX12_EXTENSION_INTRINSIC_BALLOT                 = 1 << 4,
+  AGS_DX12_EXTENSION_INTRINSIC_MBCOUNT                = 1 << 5,
+  AGS_DX12_EXTENSION_INTRINSIC_MED3                   = 1 << 6,
+  AGS_DX12_EXTENSION_INTRINSIC_BARYCENTRICS           = 1 << 7,
+  AGS_DX12_EXTENSION_INTRINSIC_WAVE_REDUCE            = 1 << 8,
+  AGS_DX12_EXTENSION_INTRINSIC_WAVE_SCAN              = 1 << 9,
+  AGS_DX12_EXTENSION_USER_MARKERS                     = 1 << 10,
+  AGS_DX12_EXTENSION_APP_REGISTRATION                 = 1 << 11,
+  AGS_DX12_EXTENSION_INTRINSIC_UAV_BIND_SLOT          = 1 << 12,
+};
+#endif
+
+/**
+ * \brief Explicit AFR API statistics
+ * 
+ * We only ever run on a single GPU, so the AFR
+ * APIs are effectively no-ops. Counters are kept
+ * so that we can see how often games use them.
+ */
+struct AGSAfrStats {
+  std::atomic<uint32_t> resourcesCreated      = { 0u };
+  std::atomic<uint32_t> resourcesWithHints    = { 0u };
+  std::atomic<uint64_t> notifyEndWrites       = { 0ull };
+  std::atomic<uint64_t> notifyBeginAllAccess  = { 0ull };
+  std::atomic<uint64_t> notifyEndAllAccess    = { 0ull };
+};
+
+/**
+ * \brief Multi-Draw Indirect shaping statistics
+ * 
+ * Counts MDI calls that never reach DXVK because they
+ * cannot draw anything, calls with a single draw that
+ * are issued as regular indirect draws, and calls that
+ * exceed the device's draw count limit.
+ */
+struct AGSMdiShapingStats {
+  std::atomic<uint64_t> callsElided           = { 0ull };
+  std::atomic<uint64_t> callsDemoted          = { 0ull };
+  std::atomic<uint64_t> callsSplit            = { 0ull };
+  std::atomic<uint64_t> callsClamped          = { 0ull };
+  std::atomic<uint64_t> callsEmulated         = { 0ull };
+  std::atomic<uint64_t> callsResolved         = { 0ull };
+};
+
+// Frame statistics are kept in a ring buffer indexed by
+// the frame number, so that AGS-heavy frames can be
+// correlated with frame times.
+constexpr uint32_t AGSFrameStatsRingSize = AGS_TELEMETRY_FRAME_COUNT;
+
+/**
+ * \brief Statistics for the current frame
+ * 
+ * Atomic since AGS 5.3 allows extension
+ * calls on deferred contexts. Reset on present.
+ */
+struct AGSFrameCounters {
+  std::atomic<uint64_t> mdiDraws            = { 0ull };
+  std::atomic<uint32_t> mdiCalls            = { 0u };
+  std::atomic<uint32_t> mdiCountCalls       = { 0u };
+  std::atomic<uint32_t> depthBoundsToggles  = { 0u };
+  std::atomic<uint32_t> uavOverlapScopes    = { 0u };
+  std::atomic<uint32_t> unsupportedCalls    = { 0u };
+};
+
+/**
+ * \brief Application profile
+ * 
+ * Options that are not set in a profile are -1,
+ * so that less specific profiles are not overridden.
+ */
+struct AGSProfile {
+  unsigned int  disabledExtensions  = 0u;
+  int8_t        interposer          = -1;
+  int8_t        uavBindingFilter    = -1;
+  int8_t        placementHints      = -1;
+  int8_t        clipRectFilter      = -1;
+  int8_t        telemetry           = -1;
+  int8_t        frameStats          = -1;
+  int8_t        gpuTiming           = -1;
+  int8_t        adaptiveDrawCount   = -1;
+  int8_t        cpuDrawCount        = -1;
+  int8_t        userMarkers         = -1;
+};
+
+/**
+ * \brief Shader hash
+ * 
+ * The container digest, the bytecode size and a hash of
+ * the bytecode. Unsigned shaders carry placeholder digests
+ * such as all zeroes, so the digest alone is not unique.
+ */
+struct AGSShaderHash {
+  uint64_t lo;
+  uint64_t hi;
+  uint64_t size;
+  uint64_t data;
+  
+  bool operator == (const AGSShaderHash& other) const {
+    return lo == other.lo && hi == other.hi
+        && size == other.size && data == other.data;
+  }
+};
+
+struct AGSShaderHashHash {
+  size_t operator () (const AGSShaderHash& hash) const {
+    return size_t(hash.data ^ hash.lo);
+  }
+};
+
+/**
+ * \brief Cached D3D12 shader intrinsic info
+ * 
+ * Instructions are only stored for DXBC shaders.
+ */
+struct AGSShaderIntrinsics {
+  bool used;
+  std::vector<D3D12_VK_SHADER_INTRINSIC_INSTRUCTION> instructions;
+};
+
+struct AGSDrawCountTracker;
+struct AGSEmulation;
+struct AGSGpuTiming;
+
 struct AGSContext {
   IDXGIFactory1*      dxgiFactory;
+  
+  // Loaded when the app first creates a D3D11 device and
+  // never freed, since the app keeps using the device
+  HMODULE             d3d11Module;
   ID3D11VkExtDevice*  dxvkDevice;
   ID3D11VkExtContext* dxvkContext;
   
+  // Null if DXVK predates the extended interfaces
+  ID3D11VkExtDevice1* dxvkDevice1;
+  ID3D11VkExtContext1* dxvkContext1;
+  
+  // Only loaded once the app creates a D3D12 device
+  // through AGS. We do not own a device reference.
+  HMODULE             d3d12Module;
+  ID3D12Device*       d3d12Device;
+  ID3D12VkExtDevice*  vkd3dDevice;
+  bool                userMarkersEnabled;
+  bool                d3d12AppRegistered;
+  
+  // D3D12 shader intrinsics, scanned once per shader
+  unsigned int        d3d12IntrinsicUavSlot;
+  unsigned int        d3d12IntrinsicExtensions;
+  uint64_t            d3d12IntrinsicOpcodes;
+  std::mutex          d3d12IntrinsicMutex;
+  std::unordered_map<AGSShaderHash, AGSShaderIntrinsics, AGSShaderHashHash> d3d12ShaderIntrinsics;
+  
+  bool                diskShaderCacheEnabled;
+  
+  // Profiles by section name, and the
+  // settings resolved from them
+  std::string         exeName;
+  std::unordered_map<std::string, AGSProfile> profiles;
+  
+  unsigned int        extensionMask;
+  bool                interposerEnabled;
+  int8_t              uavBindingFilterMode;
+  bool                placementHintsEnabled;
+  bool                clipRectFilterEnabled;
+  bool                telemetryEnabled;
+  bool                frameStatsEnabled;
+  bool                gpuTimingEnabled;
+  bool                adaptiveDrawCountEnabled;
+  bool                cpuDrawCountEnabled;
+  int8_t              userMarkerMode;
+  
+  unsigned int        maxClipRects;
+  unsigned int        maxDrawIndirectCount;
+  D3D11_VK_DISCARD_RECTANGLE_MODE clipRectMode;
+  std::vector<D3D11_RECT> clipRects;
+  
+  bool                appRegistered;
+  
+  unsigned int        intrinsicUavSlot;
+  unsigned int        intrinsicExtensions;
+  uint64_t            intrinsicOpcodes;
+  bool                intrinsicUavExplicit;
+  bool                intrinsicUavFilter;
+  uint64_t            uavBindingsFiltered;
+  
+  AGSAfrStats         afrStats;
+  AGSMdiShapingStats  mdiShaping;
+  
+  // Count buffers used on the immediate context. CPU writes
+  // to them through the interposer are shadowed in private
+  // data, and command lists bump the epoch to invalidate.
+  bool                drawCountShadowing;
+  uint32_t            drawCountEpoch;
+  std::unordered_set<ID3D11Resource*> drawCountBuffers;
+  
+  // Placement hints for buffers used by MDI calls, only
+  // applied once per buffer and tracked in private data
+  bool                placementHints;
+  std::mutex          placementMutex;
+  std::atomic<uint64_t> placementHintsSet;
+  std::atomic<uint64_t> placementHits;
+  
+  // Frames are only counted if the swap chain
+  // was created through AGS and could be wrapped
+  AGSFrameCounters    frameCounters;
+  std::array<AGSFrameStats, AGSFrameStatsRingSize> frameStats;
+  uint64_t            frameId;
+  int64_t             frameStartTicks;
+  std::atomic<bool>   depthBoundsEnabled;
+  
+  // Kill switches requested through shared
+  // memory, only updated on present
+  std::atomic<uint32_t> killSwitches;
+  
+  // Session totals, published through shared memory
+  std::array<std::atomic<uint64_t>, AGSTelemetryCallCount> callCounts;
+  unsigned int        extensionsSupported;
+  uint64_t            mdiDraws;
+  
+  HANDLE              telemetryMapping;
+  AGSTelemetry*       telemetry;
+  
+  // Only allocated if GPU timing is enabled
+  // and while the device is alive
+  AGSGpuTiming*       gpuTiming;
+  
+  // Only allocated if adaptive draw counts are
+  // enabled and while the device is alive
+  AGSDrawCountTracker* drawCountTracker;
+  
+  // Resources used to emulate extensions that have
+  // been switched off, created on first use
+  std::mutex          emulationMutex;
+  AGSEmulation*       emulation;
+  
   std::vector<AGSDeviceInfo> deviceInfo;
 };
@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+#include "ags_profile.h"
+
+static std::string agsTrim(
+  const std::string&                  str) {
+  size_t begin = str.find_first_not_of(" \t\r");
+  size_t end   = str.find_last_not_of(" \t\r");
+  
+  return begin != std::string::npos
+    ? str.substr(begin, end - begin + 1)
+    : std::string();
+}
+
+
+static std::string agsToLower(
+        std::string                   str) {
+  std::transform(str.begin(), str.end(), str.begin(),
+    [] (unsigned char c) { return char(std::tolower(c)); });
+  return str;
+}
+
+
+static std::string agsToUtf8(
+  const WCHAR*                        str) {
+  if (!str)
+    return std::string();
+  
+  int length = WideCharToMultiByte(CP_UTF8, 0, str, -1, nullptr, 0, nullptr, nullptr);
+  
+  if (length <= 1)
+    return std::string();
+  
+  std::string result(length - 1, '\0');
+  WideCharToMultiByte(CP_UTF8, 0, str, -1, &result[0], length, nullptr, nullptr);
+  return result;
+}
+
+
+static std::string agsGetExeName() {
+  char path[MAX_PATH + 1] = { };
+  GetModuleFileNameA(nullptr, path, MAX_PATH);
+  
+  std::string name = path;
+  size_t separator = name.find_last_of("\\/");
+  
+  if (separator != std::string::npos)
+    name = name.substr(separator + 1);
+  
+  return agsToLower(name);
+}
+
+
+static std::string agsReadFile(
+  const char*                         path) {
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ,
+    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  
+  if (file == INVALID_HANDLE_VALUE)
+    return std::string();
+  
+  std::string result;
+  char buffer[4096];
+  DWORD size = 0;
+  
+  while (ReadFile(file, buffer, sizeof(buffer), &size, nullptr) && size)
+    result.append(buffer, size);
+  
+  CloseHandle(file);
+  return result;
+}
+
+
+static bool agsParseBool(
+  const std::string&                  value,
+        int8_t*                       result) {
+  std::string lower = agsToLower(value);
+  
+  if (lower == "true" || lower == "1") {
+    *result = 1;
+    return true;
+  }
+  
+  if (lower == "false" || lower == "0") {
+    *result = 0;
+    return true;
+  }
+  
+  return false;
+}
+
+
+static bool agsParseExtensions(
+  const std::string&                  value,
+        unsigned int*                 result) {
+  static const std::vector<std::pair<const char*, unsigned int>> extNames = {{
+    { "uavoverlap",             AGS_DX11_EXTENSION_UAV_OVERLAP
+                              #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
+                              | AGS_DX11_EXTENSION_UAV_OVERLAP_DEFERRED_CONTEXTS
+                              #endif
+                              },
+    { "depthboundstest",        AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST
+                              #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
+                              | AGS_DX11_EXTENSION_DEPTH_BOUNDS_DEFERRED_CONTEXTS
+                              #endif
+                              },
+    { "multidrawindirect",      AGS_DX11_EXTENSION_MULTIDRAWINDIRECT
+                              #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 3, 0)
+                              | AGS_DX11_EXTENSION_MDI_DEFERRED_CONTEXTS
+                              #endif
+                              },
+    { "multidrawindirectcount", AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT },
+    { "multiview",              AGS_DX11_EXTENSION_MULTIVIEW },
+    { "crossfireapi",           AGS_DX11_EXTENSION_CROSSFIRE_API },
+    { "shaderintrinsics",       AGS_DX11_EXTENSION_INTRINSIC_READFIRSTLANE
+                              | AGS_DX11_EXTENSION_INTRINSIC_READLANE
+                              | AGS_DX11_EXTENSION_INTRINSIC_LANEID
+                              | AGS_DX11_EXTENSION_INTRINSIC_SWIZZLE
+                              | AGS_DX11_EXTENSION_INTRINSIC_BALLOT
+                              | AGS_DX11_EXTENSION_INTRINSIC_MBCOUNT
+                              | AGS_DX11_EXTENSION_INTRINSIC_MED3
+                              | AGS_DX11_EXTENSION_INTRINSIC_BARYCENTRICS
+                              #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+                              | AGS_DX11_EXTENSION_INTRINSIC_WAVE_REDUCE
+                              | AGS_DX11_EXTENSION_INTRINSIC_WAVE_SCAN
+                              #endif
+                              },
+    #if BUILD_VERSION >= AGS_MAKE_VERSION(5, 1, 0)
+    { "appregistration",        AGS_DX11_EXTENSION_APP_REGISTRATION },
+    #endif
+  }};
+  
+  unsigned int extensions = 0;
+  size_t begin = 0;
+  
+  while (begin <= value.size()) {
+    size_t end = value.find(',', begin);
+    
+    if (end == std::string::npos)
+      end = value.size();
+    
+    std::string name = agsToLower(agsTrim(value.substr(begin, end - begin)));
+    
+    if (!name.empty()) {
+      auto entry = std::find_if(extNames.begin(), extNames.end(),
+        [&name] (const std::pair<const char*, unsigned int>& p) { return name == p.first; });
+      
+      if (entry == extNames.end())
+        return false;
+      
+      extensions |= entry->second;
+    }
+    
+    begin = end + 1;
+  }
+  
+  *result = extensions;
+  return true;
+}
+
+
+static bool agsParseOption(
+        AGSProfile*                   profile,
+  const std::string&                  key,
+  const std::string&                  value) {
+  if (key == "ags.disableExtensions")
+    return agsParseExtensions(value, &profile->disabledExtensions);
+  
+  if (key == "ags.interposer")
+    return agsParseBool(value, &profile->interposer);
+  
+  if (key == "ags.uavBindingFilter")
+    return agsParseBool(value, &profile->uavBindingFilter);
+  
+  if (key == "ags.placementHints")
+    return agsParseBool(value, &profile->placementHints);
+  
+  if (key == "ags.clipRectFilter")
+    return agsParseBool(value, &profile->clipRectFilter);
+  
+  if (key == "ags.telemetry")
+    return agsParseBool(value, &profile->telemetry);
+  
+  if (key == "ags.frameStats")
+    return agsParseBool(value, &profile->frameStats);
+  
+  if (key == "ags.gpuTiming")
+    return agsParseBool(value, &profile->gpuTiming);
+  
+  if (key == "ags.adaptiveDrawCount")
+    return agsParseBool(value, &profile->adaptiveDrawCount);
+  
+  if (key == "ags.cpuDrawCount")
+    return agsParseBool(value, &profile->cpuDrawCount);
+  
+  if (key == "ags.userMarkers")
+    return agsParseBool(value, &profile->userMarkers);
+  
+  return false;
+}
+
+
+static void agsMergeProfile(
+        AGSProfile*                   dst,
+  const AGSProfile&                   src) {
+  dst->disabledExtensions |= src.disabledExtensions;
+  
+  if (src.interposer >= 0)        dst->interposer       = src.interposer;
+  if (src.uavBindingFilter >= 0)  dst->uavBindingFilter = src.uavBindingFilter;
+  if (src.placementHints >= 0)    dst->placementHints   = src.placementHints;
+  if (src.clipRectFilter >= 0)    dst->clipRectFilter   = src.clipRectFilter;
+  if (src.telemetry >= 0)         dst->telemetry        = src.telemetry;
+  if (src.frameStats >= 0)        dst->frameStats       = src.frameStats;
+  if (src.gpuTiming >= 0)         dst->gpuTiming        = src.gpuTiming;
+  if (src.adaptiveDrawCount >= 0) dst->adaptiveDrawCount = src.adaptiveDrawCount;
+  if (src.cpuDrawCount >= 0)      dst->cpuDrawCount     = src.cpuDrawCount;
+  if (src.userMarkers >= 0)       dst->userMarkers      = src.userMarkers;
+}
+
+
+static bool agsMergeNamedProfile(
+        AGSContext*                   context,
+        AGSProfile*                   dst,
+  const std::string&                  name) {
+  auto entry = context->profiles.find(name);
+  
+  if (entry == context->profiles.end())
+    return false;
+  
+  if (!name.empty())
+    agsLog() << "AGS profile: Using [" << name << "]";
+  agsMergeProfile(dst, entry->second);
+  return true;
+}
+
+
+static void agsGetEnvProfile(
+        AGSProfile*                   profile) {
+  const char* interposer = std::getenv("DXVK_AGS_INTERPOSER");
+  const char* gpuTiming  = std::getenv("DXVK_AGS_GPU_TIMING");
+  const char* markers    = std::getenv("DXVK_AGS_USER_MARKERS");
+  const char* drawCount  = std::getenv("DXVK_AGS_ADAPTIVE_DRAW_COUNT");
+  const char* cpuCount   = std::getenv("DXVK_AGS_CPU_DRAW_COUNT");
+  const char* telemetry  = std::getenv("DXVK_AGS_TELEMETRY");
+  const char* frameStats = std::getenv("DXVK_AGS_FRAME_STATS");
+  
+  if (interposer)
+    profile->interposer = interposer[0] == '1' ? 1 : 0;
+  
+  if (gpuTiming)
+    profile->gpuTiming = gpuTiming[0] == '1' ? 1 : 0;
+  
+  if (markers)
+    profile->userMarkers = markers[0] == '1' ? 1 : 0;
+  
+  if (drawCount)
+    profile->adaptiveDrawCount = drawCount[0] == '1' ? 1 : 0;
+  
+  if (cpuCount)
+    profile->cpuDrawCount = cpuCount[0] == '1' ? 1 : 0;
+  
+  if (telemetry)
+    profile->telemetry = telemetry[0] == '1' ? 1 : 0;
+  
+  if (frameStats)
+    profile->frameStats = frameStats[0] == '1' ? 1 : 0;
+}
+
+
+void agsProfileLoad(
+        AGSContext*                   context) {
+  context->exeName = agsGetExeName();
+  context->profiles.clear();
+  
+  const char* path = std::getenv("DXVK_AGS_CONFIG_FILE");
+  std::string config = agsReadFile(path ? path : "dxvk_ags.conf");
+  
+  // Options before the first section apply to all apps,
+  // and are stored in the profile with the empty name
+  AGSProfile* profile = &context->profiles[std::string()];
+  
+  uint32_t lineNumber = 0;
+  
+  for (size_t pos = 0; pos < config.size(); ) {
+    size_t end = std::min(config.find('\n', pos), config.size());
+    
+    std::string line = config.substr(pos, end - pos);
+    pos = end + 1;
+    
+    lineNumber += 1;
+    
+    size_t comment = line.find('#');
+    
+    if (comment != std::string::npos)
+      line.resize(comment);
+    
+    line = agsTrim(line);
+    
+    if (line.empty())
+      continue;
+    
+    if (line.front() == '[' && line.back() == ']') {
+      // Executable names are matched case-insensitively,
+      // app and engine names are matched exactly
+      std::string name = agsTrim(line.substr(1, line.size() - 2));
+      
+      if (name.compare(0, 4, "app:") && name.compare(0, 7, "engine:"))
+        name = agsToLower(name);
+      
+      profile = &context->profiles[name];
+      continue;
+    }
+    
+    size_t separator = line.find('=');
+    
+    if (separator == std::string::npos
+     || !agsParseOption(profile,
+          agsTrim(line.substr(0, separator)),
+          agsTrim(line.substr(separator + 1))))
+      agsLog() << "AGS profile: Invalid option in line " << lineNumber << ": " << line;
+  }
+  
+  agsProfileApply(context, nullptr, nullptr);
+}
+
+
+void agsProfileApply(
+        AGSContext*                   context,
+  const WCHAR*                        appName,
+  const WCHAR*                        engineName) {
+  AGSProfile profile;
+  
+  // More specific profiles take precedence
+  agsMergeNamedProfile(context, &profile, std::string());
+  agsMergeNamedProfile(context, &profile, context->exeName);
+  
+  std::string engine = agsToUtf8(engineName);
+  std::string app    = agsToUtf8(appName);
+  
+  if (!engine.empty())
+    agsMergeNamedProfile(context, &profile, "engine:" + engine);
+  
+  if (!app.empty())
+    agsMergeNamedProfile(context, &profile, "app:" + app);
+  
+  AGSProfile envProfile;
+  agsGetEnvProfile(&envProfile);
+  agsMergeProfile(&profile, envProfile);
+  
+  context->extensionMask            = ~profile.disabledExtensions;
+  context->interposerEnabled        = profile.interposer > 0;
+  context->uavBindingFilterMode     = profile.uavBindingFilter;
+  context->placementHintsEnabled    = profile.placementHints != 0;
+  context->clipRectFilterEnabled    = profile.clipRectFilter != 0;
+  context->telemetryEnabled         = profile.telemetry > 0;
+  context->frameStatsEnabled        = profile.frameStats > 0;
+  context->gpuTimingEnabled         = profile.gpuTiming > 0;
+  context->adaptiveDrawCountEnabled = profile.adaptiveDrawCount > 0;
+  context->cpuDrawCountEnabled      = profile.cpuDrawCount > 0;
+  context->userMarkerMode           = profile.userMarkers;
+}
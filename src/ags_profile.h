@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ags_private.h"
+
+/**
+ * \brief Loads application profiles
+ * 
+ * Parses the profile file once, and applies the global
+ * and executable profiles as well as environment
+ * variable overrides to the context.
+ * 
+ * The file is read from \c DXVK_AGS_CONFIG_FILE, or
+ * from \c dxvk_ags.conf in the working directory. It
+ * uses the same syntax as \c dxvk.conf, with sections
+ * selecting the executable, AGS application or engine:
+ * \code
+ * ags.telemetry = True
+ * 
+ * [game.exe]
+ * ags.disableExtensions = uavOverlap, depthBoundsTest
+ * 
+ * [app:Application Name]
+ * ags.gpuTiming = True
+ * 
+ * [engine:Engine Name]
+ * ags.uavBindingFilter = False
+ * \endcode
+ * The telemetry section is created in \c agsInit, so
+ * \c ags.telemetry only takes effect in the global
+ * and executable profiles. It is off by default.
+ * \param [in] context The AGS context
+ */
+void agsProfileLoad(
+        AGSContext*                   context);
+
+/**
+ * \brief Applies application profiles
+ * 
+ * Applies the engine and application profiles on top
+ * of the global and executable ones, once the app has
+ * told us its name. Environment variables still win.
+ * \param [in] context The AGS context
+ * \param [in] appName Application name, may be \c nullptr
+ * \param [in] engineName Engine name, may be \c nullptr
+ */
+void agsProfileApply(
+        AGSContext*                   context,
+  const WCHAR*                        appName,
+  const WCHAR*                        engineName);
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "ags_stats.h"
+
+static int64_t agsGetTicksPerSecond() {
+  static const int64_t ticksPerSecond = [] {
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    return int64_t(freq.QuadPart);
+  }();
+  
+  return ticksPerSecond;
+}
+
+
+static uint64_t agsGetFrameCallCount(
+  const AGSFrameStats&                stats) {
+  return uint64_t(stats.mdiCalls)
+       + uint64_t(stats.mdiCountCalls)
+       + uint64_t(stats.depthBoundsToggles)
+       + uint64_t(stats.uavOverlapScopes)
+       + uint64_t(stats.unsupportedCalls);
+}
+
+
+static uint32_t agsGetUavBindingsFiltered(
+        AGSContext*                   context) {
+  if (!context->intrinsicUavFilter)
+    return 0;
+  
+  // DXVK counts per present, but we run before the
+  // actual present, so use the running total instead
+  D3D11_VK_UAV_BINDING_FILTER_STATS filterStats = { };
+  context->dxvkDevice1->GetUavBindingFilterStats(&filterStats);
+  
+  uint64_t count = filterStats.TotalBindingsFiltered - context->uavBindingsFiltered;
+  context->uavBindingsFiltered = filterStats.TotalBindingsFiltered;
+  return uint32_t(std::min<uint64_t>(count, ~0u));
+}
+
+
+static unsigned int agsGetExtensionsUsed(
+        AGSContext*                   context) {
+  static const std::array<std::pair<AGSTelemetryCall, unsigned int>, 7> callPairs = {{
+    { AGSTelemetryCallMultiDrawIndirect,              AGS_DX11_EXTENSION_MULTIDRAWINDIRECT },
+    { AGSTelemetryCallMultiDrawIndexedIndirect,       AGS_DX11_EXTENSION_MULTIDRAWINDIRECT },
+    { AGSTelemetryCallMultiDrawIndirectCount,         AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT },
+    { AGSTelemetryCallMultiDrawIndexedIndirectCount,  AGS_DX11_EXTENSION_MULTIDRAWINDIRECT_COUNTINDIRECT },
+    { AGSTelemetryCallSetDepthBounds,                 AGS_DX11_EXTENSION_DEPTH_BOUNDS_TEST },
+    { AGSTelemetryCallBeginUAVOverlap,                AGS_DX11_EXTENSION_UAV_OVERLAP },
+    { AGSTelemetryCallSetViewBroadcastMasks,          AGS_DX11_EXTENSION_MULTIVIEW },
+  }};
+  
+  unsigned int extensions = 0;
+  
+  for (auto p : callPairs) {
+    if (context->callCounts[p.first].load(std::memory_order_relaxed))
+      extensions |= p.second;
+  }
+  
+  if (context->callCounts[AGSTelemetryCallCreateResource].load(std::memory_order_relaxed)
+   || context->callCounts[AGSTelemetryCallNotifyResource].load(std::memory_order_relaxed))
+    extensions |= AGS_DX11_EXTENSION_CROSSFIRE_API;
+  
+  return extensions;
+}
+
+
+static void agsPublishTelemetry(
+        AGSContext*                   context,
+  const AGSFrameStats&                stats) {
+  AGSTelemetry* telemetry = context->telemetry;
+  
+  // Single writer, so we never have to wait for anything.
+  // The fences keep the data writes between the two
+  // sequence updates, as seen from any reader.
+  uint32_t sequence = telemetry->sequence;
+  telemetry->sequence = sequence + 1;
+  std::atomic_thread_fence(std::memory_order_release);
+  
+  telemetry->extensionsSupported  = context->extensionsSupported;
+  telemetry->extensionsUsed       = agsGetExtensionsUsed(context);
+  telemetry->frameId              = context->frameId + 1;
+  telemetry->mdiDraws             = context->mdiDraws;
+  
+  for (uint32_t i = 0; i < AGSTelemetryCallCount; i++)
+    telemetry->callCounts[i] = context->callCounts[i].load(std::memory_order_relaxed);
+  
+  telemetry->frames[stats.frameId % AGS_TELEMETRY_FRAME_COUNT] = stats;
+  telemetry->killSwitchesActive   = stats.killSwitches;
+  
+  std::atomic_thread_fence(std::memory_order_release);
+  telemetry->sequence = sequence + 2;
+}
+
+
+static void agsUpdateKillSwitches(
+        AGSContext*                   context) {
+  // Applied between frames only, so that every frame
+  // is measured with one consistent set of switches
+  uint32_t killSwitches = context->telemetry->killSwitches & AGSTelemetryKillAll;
+  
+  if (context->killSwitches.exchange(killSwitches, std::memory_order_relaxed) != killSwitches) {
+    agsLog() << "AGS kill switches changed to 0x" << agsLogHex(killSwitches)
+             << " in frame " << context->frameId + 1;
+  }
+}
+
+
+void agsStatsInitTelemetry(
+        AGSContext*                   context) {
+  context->telemetryMapping = nullptr;
+  context->telemetry        = nullptr;
+  
+  DWORD processId = GetCurrentProcessId();
+  std::string name = "Local\\dxvk-ags-" + std::to_string(processId);
+  
+  HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr,
+    PAGE_READWRITE, 0, sizeof(AGSTelemetry), name.c_str());
+  
+  if (!mapping)
+    return;
+  
+  auto telemetry = reinterpret_cast<AGSTelemetry*>(MapViewOfFile(
+    mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(AGSTelemetry)));
+  
+  if (!telemetry) {
+    CloseHandle(mapping);
+    return;
+  }
+  
+  // Pages of a new section are zero-initialized, but the
+  // section may be left over from a previous agsInit
+  std::memset(telemetry, 0, sizeof(*telemetry));
+  telemetry->magic          = AGS_TELEMETRY_MAGIC;
+  telemetry->version        = AGS_TELEMETRY_VERSION;
+  telemetry->size           = sizeof(AGSTelemetry);
+  telemetry->processId      = processId;
+  telemetry->agsVersion     = BUILD_VERSION;
+  telemetry->frameCapacity  = AGS_TELEMETRY_FRAME_COUNT;
+  
+  context->telemetryMapping = mapping;
+  context->telemetry        = telemetry;
+}
+
+
+void agsStatsDestroyTelemetry(
+        AGSContext*                   context) {
+  if (!context->telemetry)
+    return;
+  
+  UnmapViewOfFile(context->telemetry);
+  CloseHandle(context->telemetryMapping);
+  
+  context->telemetryMapping = nullptr;
+  context->telemetry        = nullptr;
+}
+
+
+void agsStatsEndFrame(
+        AGSContext*                   context) {
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  
+  AGSFrameCounters& counters = context->frameCounters;
+  AGSFrameStats& stats = context->frameStats[context->frameId % AGSFrameStatsRingSize];
+  
+  stats.frameId             = context->frameId;
+  stats.frameTimeUs         = context->frameStartTicks
+    ? uint64_t(now.QuadPart - context->frameStartTicks) * 1000000 / agsGetTicksPerSecond()
+    : 0;
+  stats.mdiDraws            = counters.mdiDraws.exchange(0, std::memory_order_relaxed);
+  stats.mdiCalls            = counters.mdiCalls.exchange(0, std::memory_order_relaxed);
+  stats.mdiCountCalls       = counters.mdiCountCalls.exchange(0, std::memory_order_relaxed);
+  stats.depthBoundsToggles  = counters.depthBoundsToggles.exchange(0, std::memory_order_relaxed);
+  stats.uavOverlapScopes    = counters.uavOverlapScopes.exchange(0, std::memory_order_relaxed);
+  stats.unsupportedCalls    = counters.unsupportedCalls.exchange(0, std::memory_order_relaxed);
+  stats.killSwitches        = context->killSwitches.load(std::memory_order_relaxed);
+  stats.uavBindingsFiltered = agsGetUavBindingsFiltered(context);
+  
+  context->mdiDraws += stats.mdiDraws;
+  
+  if (context->telemetry) {
+    agsPublishTelemetry(context, stats);
+    agsUpdateKillSwitches(context);
+  }
+  
+  context->frameStartTicks = now.QuadPart;
+  context->frameId += 1;
+}
+
+
+void agsStatsLogFrames(
+        AGSContext*                   context) {
+  if (!context->frameId)
+    return;
+  
+  uint32_t frameCount = uint32_t(std::min<uint64_t>(context->frameId, AGSFrameStatsRingSize));
+  
+  std::array<const AGSFrameStats*, AGSFrameStatsRingSize> frames;
+  
+  for (uint32_t i = 0; i < frameCount; i++)
+    frames[i] = &context->frameStats[i];
+  
+  uint32_t logCount = std::min(frameCount, 8u);
+  
+  std::partial_sort(frames.begin(), frames.begin() + logCount, frames.begin() + frameCount,
+    [] (const AGSFrameStats* a, const AGSFrameStats* b) {
+      return agsGetFrameCallCount(*a) > agsGetFrameCallCount(*b);
+    });
+  
+  agsLog() << "AGS frames: " << context->frameId << " presented, heaviest of the last "
+           << frameCount << ":";
+  
+  for (uint32_t i = 0; i < logCount; i++) {
+    const AGSFrameStats& stats = *frames[i];
+    
+    if (!agsGetFrameCallCount(stats))
+      break;
+    
+    AGSLog log;
+    log << "  Frame " << stats.frameId << " (" << stats.frameTimeUs << " us): "
+        << stats.mdiCalls << " MDI calls with " << stats.mdiDraws << " draws, "
+        << stats.mdiCountCalls << " MDI count calls, "
+        << stats.depthBoundsToggles << " depth bounds toggles, "
+        << stats.uavOverlapScopes << " UAV overlap scopes, "
+        << stats.unsupportedCalls << " unsupported calls";
+    
+    if (stats.uavBindingsFiltered)
+      log << ", " << stats.uavBindingsFiltered << " UAV bindings filtered";
+    
+    if (stats.killSwitches)
+      log << ", kill switches 0x" << agsLogHex(stats.killSwitches);
+  }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ags_private.h"
+
+/**
+ * \brief Creates the telemetry section
+ * 
+ * Failure is not fatal, the shim then simply
+ * does not publish any telemetry.
+ * \param [in] context The AGS context
+ */
+void agsStatsInitTelemetry(
+        AGSContext*                   context);
+
+/**
+ * \brief Destroys the telemetry section
+ * \param [in] context The AGS context
+ */
+void agsStatsDestroyTelemetry(
+        AGSContext*                   context);
+
+/**
+ * \brief Ends the current frame
+ * 
+ * Moves the counters of the current frame into the
+ * frame statistics ring, publishes telemetry and starts
+ * a new frame. Must only be called from the thread
+ * that presents.
+ * \param [in] context The AGS context
+ */
+void agsStatsEndFrame(
+        AGSContext*                   context);
+
+/**
+ * \brief Logs frame statistics
+ * 
+ * Writes the AGS-heaviest frames that are still
+ * in the frame statistics ring to the log.
+ * \param [in] context The AGS context
+ */
+void agsStatsLogFrames(
+        AGSContext*                   context);
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * \brief Shared memory telemetry
+ * 
+ * If enabled through \c ags.telemetry or the
+ * \c DXVK_AGS_TELEMETRY environment variable,
+ * the shim publishes its counters in a shared memory
+ * section named \c Local\\dxvk-ags-<pid>, where \c pid
+ * is the decimal process ID of the game. The section
+ * contains a single \c AGSTelemetry structure, which
+ * only ever grows at the end between versions.
+ * 
+ * The structure is updated on every present that goes
+ * through the swap chain returned by CreateDevice, and
+ * is protected by a sequence lock. The writer never
+ * waits for readers. Readers must:
+ *  1. Read \c sequence, and retry if it is odd.
+ *  2. Copy the data they are interested in.
+ *  3. Read \c sequence again, and retry if it changed.
+ * 
+ * Call rates can be derived by sampling the session
+ * totals in \c callCounts together with \c frameId.
+ * 
+ * Tools may write \c killSwitches at any time in order
+ * to turn extensions off while the game is running.
+ * The shim picks up changes on the next present, and
+ * reports the switches that were in effect per frame.
+ */
+#define AGS_TELEMETRY_MAGIC         0x54534741u // 'AGST'
+#define AGS_TELEMETRY_VERSION       3u
+#define AGS_TELEMETRY_FRAME_COUNT   128u
+
+/**
+ * \brief Telemetry call counters
+ * 
+ * Indices into \c AGSTelemetry::callCounts. Calls
+ * are counted even if the extension is unsupported.
+ */
+enum AGSTelemetryCall : uint32_t {
+  AGSTelemetryCallMultiDrawIndirect             = 0,
+  AGSTelemetryCallMultiDrawIndexedIndirect      = 1,
+  AGSTelemetryCallMultiDrawIndirectCount        = 2,
+  AGSTelemetryCallMultiDrawIndexedIndirectCount = 3,
+  AGSTelemetryCallSetDepthBounds                = 4,
+  AGSTelemetryCallBeginUAVOverlap               = 5,
+  AGSTelemetryCallEndUAVOverlap                 = 6,
+  AGSTelemetryCallSetViewBroadcastMasks         = 7,
+  AGSTelemetryCallSetClipRects                  = 8,
+  AGSTelemetryCallCreateResource                = 9,
+  AGSTelemetryCallNotifyResource                = 10,
+  AGSTelemetryCallCount                         = 16,
+};
+
+/**
+ * \brief Extension kill switches
+ * 
+ * Extensions that are switched off remain reported to
+ * the game, but calls are emulated with core D3D11:
+ *  - Depth bounds tests are disabled.
+ *  - UAV overlap scopes keep all barriers.
+ *  - Multi-Draw Indirect calls are split into
+ *    individual indirect draws.
+ *  - Multi-Draw Indirect Count calls are split into
+ *    individual indirect draws as well, with the draw
+ *    count applied on the GPU by a compute shader.
+ */
+enum AGSTelemetryKillSwitch : uint32_t {
+  AGSTelemetryKillDepthBounds                   = 0x1,
+  AGSTelemetryKillUAVOverlap                    = 0x2,
+  AGSTelemetryKillMultiDrawIndirect             = 0x4,
+  AGSTelemetryKillMultiDrawIndirectCount        = 0x8,
+  AGSTelemetryKillAll                           = 0xf,
+};
+
+/**
+ * \brief Per-frame AGS statistics
+ * 
+ * Aggregates all AGS calls made between two presents.
+ * Frame times are measured from the previous present,
+ * and are zero for the very first frame. Kill switches
+ * are the ones that were in effect during the frame.
+ * Filtered UAV bindings are placeholder bindings to the
+ * intrinsic UAV slot that DXVK did not have to apply.
+ */
+struct AGSFrameStats {
+  uint64_t frameId;
+  uint64_t frameTimeUs;
+  uint64_t mdiDraws;
+  uint32_t mdiCalls;
+  uint32_t mdiCountCalls;
+  uint32_t depthBoundsToggles;
+  uint32_t uavOverlapScopes;
+  uint32_t unsupportedCalls;
+  uint32_t killSwitches;
+  uint32_t uavBindingsFiltered;
+  uint32_t reserved;
+};
+
+/**
+ * \brief Telemetry section layout
+ */
+struct AGSTelemetry {
+  uint32_t          magic;                ///< \c AGS_TELEMETRY_MAGIC
+  uint32_t          version;              ///< \c AGS_TELEMETRY_VERSION
+  uint32_t          size;                 ///< Size of this structure, in bytes
+  uint32_t          processId;            ///< Process ID of the game
+  volatile uint32_t sequence;             ///< Sequence lock, odd while the shim writes
+  uint32_t          agsVersion;           ///< AGS version the shim was built for
+  uint32_t          extensionsSupported;  ///< DX11 extension bits reported to the game
+  uint32_t          extensionsUsed;       ///< DX11 extension bits the game called into
+  uint32_t          frameCapacity;        ///< Number of entries in \c frames
+  uint32_t          reserved;
+  uint64_t          frameId;              ///< Number of frames presented so far
+  uint64_t          mdiDraws;             ///< Session total of MDI draws
+  uint64_t          callCounts[AGSTelemetryCallCount]; ///< Session totals per call
+  AGSFrameStats     frames[AGS_TELEMETRY_FRAME_COUNT]; ///< Frame \c n is at index \c n % \c frameCapacity
+  volatile uint32_t killSwitches;         ///< Kill switches requested by tools
+  uint32_t          killSwitchesActive;   ///< Kill switches currently in effect
+};
@@ -0,0 +1,357 @@
+#include <algorithm>
+
+#include "ags_timing.h"
+
+// Number of frames that may be in flight before
+// we stop recording samples instead of waiting
+constexpr uint32_t AGSGpuTimingMaxFrames  = 8;
+constexpr uint32_t AGSGpuTimingMaxSamples = 1024;
+
+struct AGSGpuTimingKey {
+  AGSTelemetryCall  call;
+  ID3D11Buffer*     buffer;
+  uint32_t          offset;
+  
+  bool operator == (const AGSGpuTimingKey& other) const {
+    return call == other.call && buffer == other.buffer && offset == other.offset;
+  }
+};
+
+struct AGSGpuTimingKeyHash {
+  size_t operator () (const AGSGpuTimingKey& key) const {
+    size_t hash = std::hash<const void*>()(key.buffer);
+    hash ^= (size_t(key.offset) << 8) + size_t(key.call) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
+struct AGSGpuTimingSite {
+  uint64_t calls;
+  uint64_t totalNs;
+  uint64_t maxNs;
+};
+
+struct AGSGpuTimingSample {
+  AGSGpuTimingKey   key;
+  ID3D11Query*      begin;
+  ID3D11Query*      end;
+};
+
+struct AGSGpuTimingFrame {
+  ID3D11Query*                    disjoint;
+  std::vector<AGSGpuTimingSample> samples;
+};
+
+struct AGSGpuTiming {
+  ID3D11Device*         device;
+  ID3D11DeviceContext*  context;
+  
+  std::vector<ID3D11Query*> freeQueries;
+  std::vector<ID3D11Query*> freeDisjointQueries;
+  
+  // Frames that have ended but are not resolved yet,
+  // followed by the frame currently being recorded
+  std::array<AGSGpuTimingFrame, AGSGpuTimingMaxFrames + 1> frames;
+  uint32_t              frameHead;
+  uint32_t              frameCount;
+  
+  uint32_t              uavOverlapSample;
+  uint64_t              droppedSamples;
+  
+  std::unordered_map<AGSGpuTimingKey, AGSGpuTimingSite, AGSGpuTimingKeyHash> sites;
+};
+
+
+static ID3D11Query* agsAllocQuery(
+        std::vector<ID3D11Query*>&    pool,
+        ID3D11Device*                 device,
+        D3D11_QUERY                   type) {
+  if (!pool.empty()) {
+    ID3D11Query* query = pool.back();
+    pool.pop_back();
+    return query;
+  }
+  
+  D3D11_QUERY_DESC desc = { type, 0 };
+  
+  ID3D11Query* query = nullptr;
+  
+  if (FAILED(device->CreateQuery(&desc, &query)))
+    return nullptr;
+  
+  return query;
+}
+
+
+static AGSGpuTimingFrame& agsGetCurrentFrame(
+        AGSGpuTiming*                 timing) {
+  return timing->frames[(timing->frameHead + timing->frameCount) % timing->frames.size()];
+}
+
+
+static bool agsResolveFrame(
+        AGSGpuTiming*                 timing,
+        AGSGpuTimingFrame&            frame) {
+  constexpr UINT flags = D3D11_ASYNC_GETDATA_DONOTFLUSH;
+  
+  D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+  
+  if (timing->context->GetData(frame.disjoint, &disjoint, sizeof(disjoint), flags) != S_OK)
+    return false;
+  
+  // Timestamps are written before the disjoint query
+  // ends, but don't rely on them all being available
+  for (const auto& sample : frame.samples) {
+    if (timing->context->GetData(sample.end, nullptr, 0, flags) != S_OK)
+      return false;
+  }
+  
+  for (const auto& sample : frame.samples) {
+    UINT64 begin = 0;
+    UINT64 end   = 0;
+    
+    timing->context->GetData(sample.begin, &begin, sizeof(begin), flags);
+    timing->context->GetData(sample.end,   &end,   sizeof(end),   flags);
+    
+    if (!disjoint.Disjoint && disjoint.Frequency && end >= begin) {
+      uint64_t ns = uint64_t(double(end - begin) * 1000000000.0 / double(disjoint.Frequency));
+      
+      AGSGpuTimingSite& site = timing->sites[sample.key];
+      site.calls   += 1;
+      site.totalNs += ns;
+      site.maxNs    = std::max(site.maxNs, ns);
+    }
+    
+    timing->freeQueries.push_back(sample.begin);
+    timing->freeQueries.push_back(sample.end);
+  }
+  
+  timing->freeDisjointQueries.push_back(frame.disjoint);
+  
+  frame.disjoint = nullptr;
+  frame.samples.clear();
+  return true;
+}
+
+
+static const char* agsGetCallName(
+        AGSTelemetryCall              call) {
+  switch (call) {
+    case AGSTelemetryCallMultiDrawIndirect:             return "MultiDrawInstancedIndirect";
+    case AGSTelemetryCallMultiDrawIndexedIndirect:      return "MultiDrawIndexedInstancedIndirect";
+    case AGSTelemetryCallMultiDrawIndirectCount:        return "MultiDrawInstancedIndirectCountIndirect";
+    case AGSTelemetryCallMultiDrawIndexedIndirectCount: return "MultiDrawIndexedInstancedIndirectCountIndirect";
+    case AGSTelemetryCallBeginUAVOverlap:               return "UAVOverlap";
+    default:                                            return "Unknown";
+  }
+}
+
+
+static void agsLogTimingSites(
+        AGSGpuTiming*                 timing) {
+  using SiteEntry = std::pair<AGSGpuTimingKey, AGSGpuTimingSite>;
+  
+  std::vector<SiteEntry> sites(timing->sites.begin(), timing->sites.end());
+  
+  std::sort(sites.begin(), sites.end(), [] (const SiteEntry& a, const SiteEntry& b) {
+    return a.second.totalNs > b.second.totalNs;
+  });
+  
+  if (sites.size() > 16)
+    sites.resize(16);
+  
+  agsLog() << "AGS GPU timing: " << timing->sites.size() << " call sites, "
+           << timing->droppedSamples << " samples dropped";
+  
+  for (const auto& entry : sites) {
+    const AGSGpuTimingKey&  key  = entry.first;
+    const AGSGpuTimingSite& site = entry.second;
+    
+    AGSLog log;
+    log << "  " << agsGetCallName(key.call);
+    
+    if (key.buffer)
+      log << " (args " << key.buffer << " + " << key.offset << ")";
+    
+    log << ": " << site.calls << " calls, "
+        << (site.totalNs / site.calls) / 1000 << " us avg, "
+        << site.maxNs / 1000 << " us max, "
+        << site.totalNs / 1000000 << " ms total";
+  }
+}
+
+
+void agsTimingInit(
+        AGSContext*                   context) {
+  context->gpuTiming = nullptr;
+  
+  if (!context->gpuTimingEnabled)
+    return;
+  
+  auto timing = new AGSGpuTiming();
+  context->dxvkDevice->QueryInterface(IID_PPV_ARGS(&timing->device));
+  context->dxvkContext->QueryInterface(IID_PPV_ARGS(&timing->context));
+  
+  timing->frameHead         = 0;
+  timing->frameCount        = 0;
+  timing->uavOverlapSample  = AGSGpuTimingNone;
+  timing->droppedSamples    = 0;
+  
+  for (auto& frame : timing->frames) {
+    frame.disjoint = nullptr;
+    frame.samples.reserve(AGSGpuTimingMaxSamples);
+  }
+  
+  context->gpuTiming = timing;
+}
+
+
+void agsTimingDestroy(
+        AGSContext*                   context) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  
+  if (!timing)
+    return;
+  
+  agsLogTimingSites(timing);
+  
+  for (auto& frame : timing->frames) {
+    if (frame.disjoint)
+      frame.disjoint->Release();
+    
+    for (const auto& sample : frame.samples) {
+      sample.begin->Release();
+      sample.end->Release();
+    }
+  }
+  
+  for (auto query : timing->freeQueries)
+    query->Release();
+  
+  for (auto query : timing->freeDisjointQueries)
+    query->Release();
+  
+  timing->context->Release();
+  timing->device->Release();
+  
+  delete timing;
+  context->gpuTiming = nullptr;
+}
+
+
+void agsTimingEndFrame(
+        AGSContext*                   context) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  
+  if (!timing)
+    return;
+  
+  // A scope that is still open at the end of the
+  // frame would span multiple frames, so end it here
+  if (timing->uavOverlapSample != AGSGpuTimingNone) {
+    agsTimingEndSample(context, timing->uavOverlapSample);
+    timing->uavOverlapSample = AGSGpuTimingNone;
+  }
+  
+  AGSGpuTimingFrame& current = agsGetCurrentFrame(timing);
+  
+  if (current.disjoint) {
+    timing->context->End(current.disjoint);
+    timing->frameCount += 1;
+  }
+  
+  while (timing->frameCount) {
+    if (!agsResolveFrame(timing, timing->frames[timing->frameHead]))
+      break;
+    
+    timing->frameHead = (timing->frameHead + 1) % timing->frames.size();
+    timing->frameCount -= 1;
+  }
+}
+
+
+uint32_t agsTimingBeginSample(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        AGSTelemetryCall              call,
+        ID3D11Buffer*                 buffer,
+        uint32_t                      offset) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  
+  if (dxvkContext != context->dxvkContext)
+    return AGSGpuTimingNone;
+  
+  // Drop samples rather than wait for the GPU
+  // if too many frames are still in flight
+  AGSGpuTimingFrame& frame = agsGetCurrentFrame(timing);
+  
+  if (timing->frameCount == AGSGpuTimingMaxFrames
+   || frame.samples.size() == AGSGpuTimingMaxSamples) {
+    timing->droppedSamples += 1;
+    return AGSGpuTimingNone;
+  }
+  
+  if (!frame.disjoint) {
+    frame.disjoint = agsAllocQuery(timing->freeDisjointQueries,
+      timing->device, D3D11_QUERY_TIMESTAMP_DISJOINT);
+    
+    if (!frame.disjoint)
+      return AGSGpuTimingNone;
+    
+    timing->context->Begin(frame.disjoint);
+  }
+  
+  AGSGpuTimingSample sample;
+  sample.key    = { call, buffer, offset };
+  sample.begin  = agsAllocQuery(timing->freeQueries, timing->device, D3D11_QUERY_TIMESTAMP);
+  sample.end    = agsAllocQuery(timing->freeQueries, timing->device, D3D11_QUERY_TIMESTAMP);
+  
+  if (!sample.begin || !sample.end) {
+    if (sample.begin) timing->freeQueries.push_back(sample.begin);
+    if (sample.end)   timing->freeQueries.push_back(sample.end);
+    return AGSGpuTimingNone;
+  }
+  
+  timing->context->End(sample.begin);
+  
+  frame.samples.push_back(sample);
+  return uint32_t(frame.samples.size() - 1);
+}
+
+
+void agsTimingBeginUAVOverlap(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  
+  if (timing->uavOverlapSample != AGSGpuTimingNone)
+    return;
+  
+  timing->uavOverlapSample = agsTimingBeginSample(context,
+    dxvkContext, AGSTelemetryCallBeginUAVOverlap, nullptr, 0);
+}
+
+
+void agsTimingEndUAVOverlap(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  
+  if (dxvkContext != context->dxvkContext
+   || timing->uavOverlapSample == AGSGpuTimingNone)
+    return;
+  
+  agsTimingEndSample(context, timing->uavOverlapSample);
+  timing->uavOverlapSample = AGSGpuTimingNone;
+}
+
+
+void agsTimingEndSample(
+        AGSContext*                   context,
+        uint32_t                      sample) {
+  AGSGpuTiming* timing = context->gpuTiming;
+  AGSGpuTimingFrame& frame = agsGetCurrentFrame(timing);
+  
+  if (sample < frame.samples.size())
+    timing->context->End(frame.samples[sample].end);
+}
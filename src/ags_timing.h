@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ags_private.h"
+
+struct AGSGpuTiming;
+
+constexpr uint32_t AGSGpuTimingNone = ~0u;
+
+/**
+ * \brief Initializes GPU timing
+ * 
+ * Does nothing unless GPU timing is enabled.
+ * \param [in] context The AGS context
+ */
+void agsTimingInit(
+        AGSContext*                   context);
+
+/**
+ * \brief Destroys GPU timing state
+ * 
+ * Logs the most expensive call sites
+ * that have been resolved so far.
+ * \param [in] context The AGS context
+ */
+void agsTimingDestroy(
+        AGSContext*                   context);
+
+/**
+ * \brief Ends GPU timing for the current frame
+ * 
+ * Resolves timestamps of previous frames that are
+ * available without flushing, and never waits.
+ * \param [in] context The AGS context
+ */
+void agsTimingEndFrame(
+        AGSContext*                   context);
+
+/**
+ * \brief Begins a timed call
+ * 
+ * Writes a timestamp before the call. Only calls on
+ * the immediate context are timed, since we cannot
+ * read back queries from deferred contexts.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context the call is recorded into
+ * \param [in] call Call type, used for the call site key
+ * \param [in] buffer Argument buffer, used for the call site key
+ * \param [in] offset Argument offset, used for the call site key
+ * \returns Sample index, or \c AGSGpuTimingNone
+ */
+uint32_t agsTimingBeginSample(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        AGSTelemetryCall              call,
+        ID3D11Buffer*                 buffer,
+        uint32_t                      offset);
+
+/**
+ * \brief Ends a timed call
+ * 
+ * Writes a timestamp after the call.
+ * \param [in] context The AGS context
+ * \param [in] sample Sample index
+ */
+void agsTimingEndSample(
+        AGSContext*                   context,
+        uint32_t                      sample);
+
+/**
+ * \brief Begins a timed UAV overlap scope
+ * 
+ * Scopes that are still open at the end of
+ * the frame get closed at the frame boundary.
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context the scope is recorded into
+ */
+void agsTimingBeginUAVOverlap(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext);
+
+/**
+ * \brief Ends a timed UAV overlap scope
+ * \param [in] context The AGS context
+ * \param [in] dxvkContext Context the scope is recorded into
+ */
+void agsTimingEndUAVOverlap(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext);
+
+
+inline uint32_t agsTimingBegin(
+        AGSContext*                   context,
+        ID3D11VkExtContext*           dxvkContext,
+        AGSTelemetryCall              call,
+        ID3D11Buffer*                 buffer,
+        uint32_t                      offset) {
+  return context->gpuTiming
+    ? agsTimingBeginSample(context, dxvkContext, call, buffer, offset)
+    : AGSGpuTimingNone;
+}
+
+
+inline void agsTimingEnd(
+        AGSContext*                   context,
+        uint32_t                      sample) {
+  if (sample != AGSGpuTimingNone)
+    agsTimingEndSample(context, sample);
+}
@@ -0,0 +1,460 @@
+#include <array>
+#include <cstring>
+
+#include "dxbc_intrinsics.h"
+
+namespace {
+
+  constexpr uint32_t DxbcOpcodeCustomData       = 53;
+  constexpr uint32_t DxbcOpcodeDclFirstSm4      = 88;
+  constexpr uint32_t DxbcOpcodeDclLastSm4       = 106;
+  constexpr uint32_t DxbcOpcodeDclFirstSm5      = 143;
+  constexpr uint32_t DxbcOpcodeDclLastSm5       = 162;
+  constexpr uint32_t DxbcOpcodeDclGsInstances   = 206;
+  constexpr uint32_t DxbcOpcodeDclUavTyped      = 156;
+  constexpr uint32_t DxbcOpcodeDclUavRaw        = 157;
+  constexpr uint32_t DxbcOpcodeDclUavStructured = 158;
+  constexpr uint32_t DxbcOpcodeImmAtomicCmpExch = 185;
+  
+  constexpr uint32_t DxbcOperandTypeImm32       = 4;
+  constexpr uint32_t DxbcOperandTypeImm64       = 5;
+  constexpr uint32_t DxbcOperandTypeUav         = 30;
+  
+  constexpr uint32_t DxbcIndexImm32             = 0;
+  constexpr uint32_t DxbcIndexImm64             = 1;
+  constexpr uint32_t DxbcIndexRelative          = 2;
+  constexpr uint32_t DxbcIndexImm32Relative     = 3;
+  constexpr uint32_t DxbcIndexImm64Relative     = 4;
+  
+  constexpr uint32_t AmdIntrinsicMagicCode      = 0x5;
+  
+  // Pipeline state validation resource types
+  constexpr uint32_t DxilPsvUavTyped            = 6;
+  constexpr uint32_t DxilPsvUavWithCounter      = 9;
+  
+  /**
+   * \brief Decoded operand
+   * 
+   * Indices are \c ~0u if they are not
+   * immediates or not present at all.
+   */
+  struct DxbcOperandInfo {
+    uint32_t type;
+    uint32_t index[3];
+    uint32_t imm;
+  };
+  
+  /**
+   * \brief SM 5.1 UAV range declaration
+   * 
+   * Instructions refer to UAVs through the range ID,
+   * with the register number as the second index.
+   */
+  struct DxbcUavRange {
+    uint32_t id;
+    uint32_t lower;
+    uint32_t upper;
+    uint32_t space;
+  };
+  
+  
+  uint32_t dxbcReadDword(const uint8_t* ptr) {
+    uint32_t result;
+    std::memcpy(&result, ptr, sizeof(result));
+    return result;
+  }
+  
+  
+  bool dxbcDecodeOperand(
+    const uint32_t*&                    ptr,
+    const uint32_t*                     end,
+          DxbcOperandInfo*              info) {
+    if (ptr >= end)
+      return false;
+    
+    uint32_t token = *(ptr++);
+    uint32_t componentCount = token & 0x3;
+    uint32_t type           = (token >> 12) & 0xff;
+    uint32_t indexDim       = (token >> 20) & 0x3;
+    
+    // Skip extended operand tokens
+    bool extended = token >> 31;
+    
+    while (extended) {
+      if (ptr >= end)
+        return false;
+      
+      extended = *(ptr++) >> 31;
+    }
+    
+    if (info) {
+      info->type      = type;
+      info->index[0]  = ~0u;
+      info->index[1]  = ~0u;
+      info->index[2]  = ~0u;
+      info->imm       = 0;
+    }
+    
+    if (type == DxbcOperandTypeImm32 || type == DxbcOperandTypeImm64) {
+      uint32_t dwordCount = componentCount == 2 ? 4 : 1;
+      
+      if (type == DxbcOperandTypeImm64)
+        dwordCount *= 2;
+      
+      if (ptr + dwordCount > end)
+        return false;
+      
+      if (info)
+        info->imm = ptr[0];
+      
+      ptr += dwordCount;
+      return true;
+    }
+    
+    for (uint32_t i = 0; i < indexDim; i++) {
+      uint32_t repr = (token >> (22 + 3 * i)) & 0x7;
+      
+      switch (repr) {
+        case DxbcIndexImm32:
+        case DxbcIndexImm32Relative:
+          if (ptr >= end)
+            return false;
+          
+          if (info && repr == DxbcIndexImm32)
+            info->index[i] = ptr[0];
+          
+          ptr += 1;
+          break;
+        
+        case DxbcIndexImm64:
+        case DxbcIndexImm64Relative:
+          if (ptr + 2 > end)
+            return false;
+          
+          ptr += 2;
+          break;
+        
+        case DxbcIndexRelative:
+          break;
+        
+        default:
+          return false;
+      }
+      
+      if (repr == DxbcIndexRelative
+       || repr == DxbcIndexImm32Relative
+       || repr == DxbcIndexImm64Relative) {
+        if (!dxbcDecodeOperand(ptr, end, nullptr))
+          return false;
+      }
+    }
+    
+    return true;
+  }
+  
+  
+  bool dxbcFindChunk(
+    const uint8_t*                      pBytecode,
+          size_t                        length,
+    const char*                         name,
+    const uint8_t**                     pChunk,
+          size_t*                       pChunkSize) {
+    // Container header: magic, checksum, version, size, chunk count
+    if (length < 32 || std::memcmp(pBytecode, "DXBC", 4))
+      return false;
+    
+    uint32_t chunkCount = dxbcReadDword(pBytecode + 28);
+    
+    if (32 + 4 * size_t(chunkCount) > length)
+      return false;
+    
+    for (uint32_t i = 0; i < chunkCount; i++) {
+      size_t chunkOffset = dxbcReadDword(pBytecode + 32 + 4 * i);
+      
+      if (chunkOffset + 8 > length)
+        return false;
+      
+      const uint8_t* chunk = pBytecode + chunkOffset;
+      size_t chunkSize = dxbcReadDword(chunk + 4);
+      
+      if (chunkOffset + 8 + chunkSize > length)
+        return false;
+      
+      if (std::memcmp(chunk, name, 4))
+        continue;
+      
+      // Chunk data is always dword-aligned in valid containers
+      if (chunkOffset & 0x3)
+        return false;
+      
+      *pChunk     = chunk + 8;
+      *pChunkSize = chunkSize;
+      return true;
+    }
+    
+    return false;
+  }
+  
+  
+  bool dxbcFindProgram(
+    const uint8_t*                      pBytecode,
+          size_t                        length,
+    const uint32_t**                    pProgram,
+          size_t*                       pProgramLength) {
+    const uint8_t* chunk     = nullptr;
+    size_t         chunkSize = 0;
+    
+    if (!dxbcFindChunk(pBytecode, length, "SHEX", &chunk, &chunkSize)
+     && !dxbcFindChunk(pBytecode, length, "SHDR", &chunk, &chunkSize))
+      return false;
+    
+    if (chunkSize < 8)
+      return false;
+    
+    auto program = reinterpret_cast<const uint32_t*>(chunk);
+    size_t programLength = program[1];
+    
+    if (programLength < 2 || 4 * programLength > chunkSize)
+      return false;
+    
+    *pProgram       = program;
+    *pProgramLength = programLength;
+    return true;
+  }
+  
+  
+  bool dxbcIsUavDeclaration(
+          uint32_t                      opcode) {
+    return opcode == DxbcOpcodeDclUavTyped
+        || opcode == DxbcOpcodeDclUavRaw
+        || opcode == DxbcOpcodeDclUavStructured;
+  }
+  
+  
+  /**
+   * \brief Checks whether an instruction is a declaration
+   * 
+   * Declarations may have tokens that are not operands,
+   * everything else only consists of operands.
+   */
+  bool dxbcIsDeclaration(
+          uint32_t                      opcode) {
+    return opcode == DxbcOpcodeCustomData
+        || (opcode >= DxbcOpcodeDclFirstSm4 && opcode <= DxbcOpcodeDclLastSm4)
+        || (opcode >= DxbcOpcodeDclFirstSm5 && opcode <= DxbcOpcodeDclLastSm5)
+        || opcode == DxbcOpcodeDclGsInstances;
+  }
+  
+  
+  /**
+   * \brief Checks whether a UAV operand may refer to the slot
+   * 
+   * Dynamically indexed SM 5.1 UAVs may refer to the slot
+   * if it is part of the range. Operands that we cannot
+   * resolve are assumed to refer to the slot.
+   */
+  bool dxbcUavMayAccessSlot(
+    const DxbcOperandInfo&              uav,
+    const std::vector<DxbcUavRange>&    uavRanges,
+          bool                          hasSpaces,
+          uint32_t                      uavSpace,
+          uint32_t                      uavSlot) {
+    if (!hasSpaces)
+      return uavSpace == 0 && (uav.index[0] == uavSlot || uav.index[0] == ~0u);
+    
+    for (const auto& range : uavRanges) {
+      if (range.id != uav.index[0])
+        continue;
+      
+      if (range.space != uavSpace)
+        return false;
+      
+      return uav.index[1] == ~0u
+        ? range.lower <= uavSlot && uavSlot <= range.upper
+        : uav.index[1] == uavSlot;
+    }
+    
+    return true;
+  }
+
+}
+
+
+bool dxbcScanIntrinsics(
+  const void*                         pBytecode,
+        size_t                        length,
+        uint32_t                      uavSpace,
+        uint32_t                      uavSlot,
+        std::vector<DxbcIntrinsic>&   intrinsics,
+        uint32_t*                     pAccessCount) {
+  intrinsics.clear();
+  
+  if (pAccessCount)
+    *pAccessCount = 0;
+  
+  const uint32_t* program       = nullptr;
+  size_t          programLength = 0;
+  
+  if (!pBytecode || !dxbcFindProgram(
+      reinterpret_cast<const uint8_t*>(pBytecode),
+      length, &program, &programLength))
+    return false;
+  
+  const uint32_t* end = program + programLength;
+  const uint32_t* ins = program + 2;
+  
+  // Only SM 5.1 has register spaces, older
+  // shaders implicitly use space 0 for everything
+  bool hasSpaces = (program[0] & 0xff) >= 0x51;
+  
+  std::vector<DxbcUavRange> uavRanges;
+  uint32_t accessCount = 0;
+  
+  while (ins < end) {
+    uint32_t opcode = ins[0] & 0x7ff;
+    uint32_t insLength = opcode == DxbcOpcodeCustomData
+      ? (ins + 1 < end ? ins[1] : 0)
+      : (ins[0] >> 24) & 0x7f;
+    
+    if (!insLength || ins + insLength > end)
+      return false;
+    
+    const uint32_t* ptr    = ins + 1;
+    const uint32_t* insEnd = ins + insLength;
+    
+    // Skip extended opcode tokens
+    bool extended = opcode != DxbcOpcodeCustomData && (ins[0] >> 31);
+    
+    while (extended && ptr < insEnd)
+      extended = *(ptr++) >> 31;
+    
+    if (hasSpaces && dxbcIsUavDeclaration(opcode)) {
+      // The register space is always the last token
+      DxbcOperandInfo uav;
+      
+      if (dxbcDecodeOperand(ptr, insEnd, &uav) && ptr < insEnd)
+        uavRanges.push_back({ uav.index[0], uav.index[1], uav.index[2], insEnd[-1] });
+    }
+    
+    if (!dxbcIsDeclaration(opcode)) {
+      // Operands of atomic compare-exchange are
+      // dst, uav, address, compare, value
+      std::array<DxbcOperandInfo, 3> operands = { };
+      uint32_t operandCount = 0;
+      
+      bool mayAccess = false;
+      
+      while (ptr < insEnd) {
+        DxbcOperandInfo operand;
+        
+        if (!dxbcDecodeOperand(ptr, insEnd, &operand)) {
+          mayAccess = true;
+          break;
+        }
+        
+        if (operand.type == DxbcOperandTypeUav)
+          mayAccess |= dxbcUavMayAccessSlot(operand, uavRanges, hasSpaces, uavSpace, uavSlot);
+        
+        if (operandCount < operands.size())
+          operands[operandCount] = operand;
+        
+        operandCount += 1;
+      }
+      
+      if (mayAccess)
+        accessCount += 1;
+      
+      const DxbcOperandInfo& uav  = operands[1];
+      const DxbcOperandInfo& addr = operands[2];
+      
+      // Intrinsics always use the slot directly
+      uint32_t uavIndex = hasSpaces ? uav.index[1] : uav.index[0];
+      
+      if (opcode == DxbcOpcodeImmAtomicCmpExch
+       && operandCount >= operands.size()
+       && uav.type == DxbcOperandTypeUav && uavIndex == uavSlot
+       && dxbcUavMayAccessSlot(uav, uavRanges, hasSpaces, uavSpace, uavSlot)
+       && addr.type == DxbcOperandTypeImm32
+       && (addr.imm >> 28) == AmdIntrinsicMagicCode) {
+        DxbcIntrinsic intrinsic;
+        intrinsic.offset = uint32_t(ins - program);
+        intrinsic.opcode = (addr.imm >>  0) & 0xff;
+        intrinsic.phase  = (addr.imm >> 24) & 0x3;
+        intrinsic.data   = (addr.imm >>  8) & 0xffff;
+        intrinsics.push_back(intrinsic);
+      }
+    }
+    
+    ins += insLength;
+  }
+  
+  if (pAccessCount)
+    *pAccessCount = accessCount;
+  
+  return true;
+}
+
+
+bool dxbcIsDxil(
+  const void*                         pBytecode,
+        size_t                        length) {
+  const uint8_t* chunk     = nullptr;
+  size_t         chunkSize = 0;
+  
+  return pBytecode && dxbcFindChunk(
+    reinterpret_cast<const uint8_t*>(pBytecode),
+    length, "DXIL", &chunk, &chunkSize);
+}
+
+
+bool dxilHasIntrinsicUav(
+  const void*                         pBytecode,
+        size_t                        length,
+        uint32_t                      uavSpace,
+        uint32_t                      uavSlot) {
+  const uint8_t* psv     = nullptr;
+  size_t         psvSize = 0;
+  
+  if (!pBytecode || !dxbcFindChunk(
+      reinterpret_cast<const uint8_t*>(pBytecode),
+      length, "PSV0", &psv, &psvSize))
+    return false;
+  
+  // Runtime info of variable size, followed by the resource
+  // count, the size of each binding and the bindings. Each
+  // binding starts with type, space, lower and upper bound.
+  if (psvSize < 4)
+    return false;
+  
+  size_t offset = 4 + size_t(dxbcReadDword(psv));
+  
+  if (offset + 4 > psvSize)
+    return false;
+  
+  uint32_t resourceCount = dxbcReadDword(psv + offset);
+  offset += 4;
+  
+  if (!resourceCount || offset + 4 > psvSize)
+    return false;
+  
+  uint32_t bindingSize = dxbcReadDword(psv + offset);
+  offset += 4;
+  
+  if (bindingSize < 16 || offset + size_t(resourceCount) * bindingSize > psvSize)
+    return false;
+  
+  for (uint32_t i = 0; i < resourceCount; i++) {
+    const uint8_t* binding = psv + offset + size_t(i) * bindingSize;
+    
+    uint32_t type  = dxbcReadDword(binding +  0);
+    uint32_t space = dxbcReadDword(binding +  4);
+    uint32_t lower = dxbcReadDword(binding +  8);
+    uint32_t upper = dxbcReadDword(binding + 12);
+    
+    if (type >= DxilPsvUavTyped && type <= DxilPsvUavWithCounter
+     && space == uavSpace && lower <= uavSlot && uavSlot <= upper)
+      return true;
+  }
+  
+  return false;
+}
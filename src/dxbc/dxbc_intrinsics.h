@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief AMD shader intrinsic opcodes
+ *
+ * Matches the opcodes used by the HLSL helpers that
+ * ship with the AGS SDK. Each intrinsic is encoded as
+ * an \c InterlockedCompareExchange on the reserved
+ * UAV, with the encoded instruction as the address.
+ */
+enum DxbcIntrinsicOpcode : uint32_t {
+  DxbcIntrinsicReadfirstlane  = 0x01,
+  DxbcIntrinsicReadlane       = 0x02,
+  DxbcIntrinsicLaneId         = 0x03,
+  DxbcIntrinsicSwizzle        = 0x04,
+  DxbcIntrinsicBallot         = 0x05,
+  DxbcIntrinsicMBCnt          = 0x06,
+  DxbcIntrinsicMin3U          = 0x07,
+  DxbcIntrinsicMin3F          = 0x08,
+  DxbcIntrinsicMed3U          = 0x09,
+  DxbcIntrinsicMed3F          = 0x0a,
+  DxbcIntrinsicMax3U          = 0x0b,
+  DxbcIntrinsicMax3F          = 0x0c,
+  DxbcIntrinsicBaryCoord      = 0x0d,
+  DxbcIntrinsicVtxParam       = 0x0e,
+  DxbcIntrinsicWaveReduce     = 0x12,
+  DxbcIntrinsicWaveScan       = 0x13,
+};
+
+/**
+ * \brief Wave reduce and scan operations
+ *
+ * Stored in the lower 8 bits of the immediate
+ * data for wave reduce and wave scan intrinsics.
+ */
+enum DxbcIntrinsicWaveOp : uint32_t {
+  DxbcIntrinsicWaveOpAddF     = 0x01,
+  DxbcIntrinsicWaveOpAddI     = 0x02,
+  DxbcIntrinsicWaveOpAddU     = 0x03,
+  DxbcIntrinsicWaveOpMulF     = 0x04,
+  DxbcIntrinsicWaveOpMulI     = 0x05,
+  DxbcIntrinsicWaveOpMulU     = 0x06,
+  DxbcIntrinsicWaveOpMinF     = 0x07,
+  DxbcIntrinsicWaveOpMinI     = 0x08,
+  DxbcIntrinsicWaveOpMinU     = 0x09,
+  DxbcIntrinsicWaveOpMaxF     = 0x0a,
+  DxbcIntrinsicWaveOpMaxI     = 0x0b,
+  DxbcIntrinsicWaveOpMaxU     = 0x0c,
+  DxbcIntrinsicWaveOpAnd      = 0x0d,
+  DxbcIntrinsicWaveOpOr       = 0x0e,
+  DxbcIntrinsicWaveOpXor      = 0x0f,
+};
+
+/**
+ * \brief Wave scan flags
+ *
+ * Stored in bits 8-15 of the immediate
+ * data for wave scan intrinsics.
+ */
+enum DxbcIntrinsicWaveScanFlag : uint32_t {
+  DxbcIntrinsicWaveScanInclusive  = 0x01,
+  DxbcIntrinsicWaveScanExclusive  = 0x02,
+};
+
+/**
+ * \brief Intrinsic instruction
+ */
+struct DxbcIntrinsic {
+  uint32_t offset;  ///< Dword offset of the instruction, relative to the program version token
+  uint32_t opcode;  ///< Intrinsic opcode
+  uint32_t phase;   ///< Opcode phase for intrinsics that take multiple instructions
+  uint32_t data;    ///< Immediate data
+};
+
+/**
+ * \brief Scans DXBC shader for AMD intrinsics
+ *
+ * Looks for atomic compare-exchange instructions on the
+ * given UAV slot whose address operand is an immediate
+ * carrying the AMD intrinsic magic code. For SM 5.1
+ * shaders, the UAV must also be in the given register
+ * space. Older shaders only have space 0.
+ * 
+ * Also counts all instructions that may access the
+ * UAV, including the intrinsics. If the count equals
+ * the number of intrinsics, the UAV is not needed
+ * once all intrinsics are translated.
+ * \param [in] pBytecode DXBC shader container
+ * \param [in] length Size of the container, in bytes
+ * \param [in] uavSpace Register space reserved for intrinsics
+ * \param [in] uavSlot UAV slot reserved for intrinsics
+ * \param [out] intrinsics Intrinsic instructions found
+ * \param [out] pAccessCount Number of instructions that
+ *    may access the UAV, may be \c nullptr
+ * \returns \c false if the shader could not be parsed
+ */
+bool dxbcScanIntrinsics(
+  const void*                         pBytecode,
+        size_t                        length,
+        uint32_t                      uavSpace,
+        uint32_t                      uavSlot,
+        std::vector<DxbcIntrinsic>&   intrinsics,
+        uint32_t*                     pAccessCount);
+
+/**
+ * \brief Checks whether a shader container holds DXIL
+ *
+ * \param [in] pBytecode Shader container
+ * \param [in] length Size of the container, in bytes
+ * \returns \c true if the container has a DXIL chunk
+ */
+bool dxbcIsDxil(
+  const void*                         pBytecode,
+        size_t                        length);
+
+/**
+ * \brief Checks whether a DXIL shader binds the intrinsic UAV
+ *
+ * Looks at the resource bindings in the pipeline state
+ * validation chunk, which is a lot cheaper than parsing
+ * the bitcode. The intrinsic instructions themselves
+ * have to be decoded by the DXIL compiler.
+ * \param [in] pBytecode DXIL shader container
+ * \param [in] length Size of the container, in bytes
+ * \param [in] uavSpace Register space reserved for intrinsics
+ * \param [in] uavSlot UAV slot reserved for intrinsics
+ * \returns \c true if a UAV binding covers the slot
+ */
+bool dxilHasIntrinsicUav(
+  const void*                         pBytecode,
+        size_t                        length,
+        uint32_t                      uavSpace,
+        uint32_t                      uavSlot);
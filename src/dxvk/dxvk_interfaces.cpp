@@ -1,4 +1,6 @@
 #include "../ags_private.h"
 
 const GUID ID3D11VkExtDevice::guid      = {0x8a6e3c42,0xf74c,0x45b7,{0x82,0x65,0xa2,0x31,0xb6,0x77,0xca,0x17}};
+const GUID ID3D11VkExtDevice1::guid     = {0xdd1138c2,0x35ee,0x453c,{0xaa,0xe0,0x39,0x37,0xf8,0x2c,0x74,0x19}};
 const GUID ID3D11VkExtContext::guid     = {0xfd0bca13,0x5cb6,0x4c3a,{0x98,0x7e,0x47,0x50,0xde,0x2c,0xa7,0x91}};
+const GUID ID3D11VkExtContext1::guid    = {0xb97365ef,0x1242,0x4682,{0x83,0xfe,0x5c,0x69,0x4d,0xc2,0xfe,0x81}};
@@ -8,12 +8,121 @@ enum D3D11_VK_EXTENSION : uint32_t {
   D3D11_VK_EXT_MULTI_DRAW_INDIRECT_COUNT  = 1,
   D3D11_VK_EXT_DEPTH_BOUNDS               = 2,
   D3D11_VK_EXT_BARRIER_CONTROL            = 3,
+  D3D11_VK_EXT_STATE_CACHE_CONTROL        = 4,
+  D3D11_VK_EXT_VIEW_BROADCAST             = 5,
+  D3D11_VK_EXT_DISCARD_RECTANGLES         = 6,
+  D3D11_VK_EXT_SHADER_INTRINSICS          = 7,
+  D3D11_VK_EXT_UAV_BINDING_FILTER         = 8,
+  D3D11_VK_EXT_RESOURCE_PLACEMENT         = 9,
+  D3D11_VK_EXT_DRAW_INDIRECT_LIMITS       = 10,
 };
 
 enum D3D11_VK_BARRIER_CONTROL : uint32_t {
   D3D11_VK_BARRIER_CONTROL_IGNORE_WRITE_AFTER_WRITE   = 1 << 0,
 };
 
+enum D3D11_VK_DEVICE_LIMIT : uint32_t {
+  D3D11_VK_DEVICE_LIMIT_MAX_DISCARD_RECTANGLES  = 0,
+  D3D11_VK_DEVICE_LIMIT_MAX_DRAW_INDIRECT_COUNT = 1,
+};
+
+enum D3D11_VK_DISCARD_RECTANGLE_MODE : uint32_t {
+  D3D11_VK_DISCARD_RECTANGLE_MODE_INCLUSIVE     = 0,
+  D3D11_VK_DISCARD_RECTANGLE_MODE_EXCLUSIVE     = 1,
+};
+
+enum D3D11_VK_SHADER_INTRINSIC : uint32_t {
+  D3D11_VK_SHADER_INTRINSIC_READFIRSTLANE       = 0x01,
+  D3D11_VK_SHADER_INTRINSIC_READLANE            = 0x02,
+  D3D11_VK_SHADER_INTRINSIC_LANEID              = 0x03,
+  D3D11_VK_SHADER_INTRINSIC_SWIZZLE             = 0x04,
+  D3D11_VK_SHADER_INTRINSIC_BALLOT              = 0x05,
+  D3D11_VK_SHADER_INTRINSIC_MBCNT               = 0x06,
+  D3D11_VK_SHADER_INTRINSIC_MIN3U               = 0x07,
+  D3D11_VK_SHADER_INTRINSIC_MIN3F               = 0x08,
+  D3D11_VK_SHADER_INTRINSIC_MED3U               = 0x09,
+  D3D11_VK_SHADER_INTRINSIC_MED3F               = 0x0a,
+  D3D11_VK_SHADER_INTRINSIC_MAX3U               = 0x0b,
+  D3D11_VK_SHADER_INTRINSIC_MAX3F               = 0x0c,
+  D3D11_VK_SHADER_INTRINSIC_BARYCOORD           = 0x0d,
+  D3D11_VK_SHADER_INTRINSIC_VTXPARAM            = 0x0e,
+  D3D11_VK_SHADER_INTRINSIC_WAVE_REDUCE         = 0x12,
+  D3D11_VK_SHADER_INTRINSIC_WAVE_SCAN           = 0x13,
+};
+
+struct D3D11_VK_SHADER_INTRINSIC_INSTRUCTION {
+  UINT                        InstructionOffset;
+  D3D11_VK_SHADER_INTRINSIC   Intrinsic;
+  UINT                        Phase;
+  UINT                        Data;
+};
+
+enum D3D11_VK_RESOURCE_PLACEMENT : uint32_t {
+  D3D11_VK_RESOURCE_PLACEMENT_DEFAULT           = 0,
+  D3D11_VK_RESOURCE_PLACEMENT_HOST_VISIBLE_VRAM = 1,
+};
+
+struct D3D11_VK_RESOURCE_PLACEMENT_STATS {
+  UINT64                      ResourcesPlaced;
+  UINT64                      BytesNotStaged;
+};
+
+struct D3D11_VK_UAV_BINDING_FILTER_STATS {
+  UINT64                      TotalBindingsFiltered;
+  UINT                        LastFrameBindingsFiltered;
+};
+
+/**
+ * \brief Shader intrinsic scan callback
+ * 
+ * Called for each DXBC shader that declares a UAV in the
+ * slot reserved for shader intrinsics. Returns the list of
+ * atomic compare-exchange instructions on that UAV that
+ * encode an intrinsic, with \c InstructionOffset being the
+ * dword offset from the program version token. If the
+ * instruction array is \c nullptr, only returns the count.
+ * 
+ * \c *pUavReleased is set to \c TRUE if the returned
+ * instructions are the only accesses to the reserved UAV
+ * in the shader, so that the shader does not need the
+ * UAV binding once they are translated.
+ * 
+ * For wave reduce and wave scan intrinsics, bits 0-7 of
+ * \c Data store the operation (add, mul, min, max, and,
+ * or, xor for float, signed and unsigned types as in the
+ * AGS shader headers), and bits 8-15 store the scan mode,
+ * which is 1 for inclusive and 2 for exclusive scans.
+ */
+typedef UINT (STDMETHODCALLTYPE *PFN_D3D11_VK_SCAN_SHADER_INTRINSICS)(
+        void*                   pUserData,
+  const void*                   pShaderBytecode,
+        SIZE_T                  BytecodeLength,
+        UINT                    MaxInstructions,
+        D3D11_VK_SHADER_INTRINSIC_INSTRUCTION* pInstructions,
+        BOOL*                   pUavReleased);
+
+struct D3D11_VK_APPLICATION_INFO {
+  const WCHAR*                pApplicationName;
+  UINT                        ApplicationVersion;
+  const WCHAR*                pEngineName;
+  UINT                        EngineVersion;
+};
+
+/**
+ * \brief Registers application info
+ * 
+ * Exported by DXVK's \c dxgi.dll as \c DXVKRegisterApplication.
+ * The names and versions are used for \c VkApplicationInfo and
+ * for matching the DXVK configuration of all Vulkan instances
+ * and devices created after the call, so that driver profiles
+ * for the game or engine get applied. Either name may be
+ * \c nullptr, in which case the default is kept.
+ * \param [in] pInfo Application info
+ * \returns \c S_OK on success
+ */
+typedef HRESULT (WINAPI *PFN_DXVK_REGISTER_APPLICATION)(
+  const D3D11_VK_APPLICATION_INFO* pInfo);
+
 MIDL_INTERFACE("8a6e3c42-f74c-45b7-8265-a231b677ca17")
 ID3D11VkExtDevice : public IUnknown {
   static const GUID guid;
@@ -29,6 +138,131 @@ ID3D11VkExtDevice : public IUnknown {
   
 };
 
+/**
+ * \brief Extended DXVK device interface
+ * 
+ * Required for all extensions past barrier control.
+ * Older DXVK builds that do not expose this interface
+ * do not support any of these extensions.
+ */
+MIDL_INTERFACE("dd1138c2-35ee-453c-aae0-3937f82c7419")
+ID3D11VkExtDevice1 : public ID3D11VkExtDevice {
+  static const GUID guid;
+  
+  /**
+   * \brief Enables or disables the state cache
+   * 
+   * Controls whether pipeline state is looked up in and
+   * written to the on-disk state cache. Only affects
+   * pipelines compiled after the call.
+   * \param [in] Enable Whether to use the state cache
+   * \returns \c E_FAIL if the state cache is disabled
+   *    by the user configuration, \c S_OK otherwise
+   */
+  virtual HRESULT STDMETHODCALLTYPE SetStateCacheEnabled(
+          BOOL                    Enable) = 0;
+  
+  /**
+   * \brief Queries a device limit
+   * 
+   * Only available if discard rectangles or draw indirect
+   * limits are supported. The draw count limit is only
+   * reported with \c D3D11_VK_EXT_DRAW_INDIRECT_LIMITS.
+   * \param [in] Limit The limit to query
+   * \returns The limit, or 0 if the limit is not known
+   */
+  virtual UINT STDMETHODCALLTYPE GetDeviceLimit(
+          D3D11_VK_DEVICE_LIMIT   Limit) = 0;
+  
+  /**
+   * \brief Checks whether a shader intrinsic is supported
+   * 
+   * Barycentric coordinates and per-vertex parameters are
+   * only supported if the device supports fragment shader
+   * barycentrics.
+   * \param [in] Intrinsic The intrinsic to check
+   * \returns \c TRUE if the intrinsic can be translated
+   *    on this device
+   */
+  virtual BOOL STDMETHODCALLTYPE GetShaderIntrinsicSupport(
+          D3D11_VK_SHADER_INTRINSIC Intrinsic) = 0;
+  
+  /**
+   * \brief Installs shader intrinsic hook
+   * 
+   * Instructions reported by the callback are translated
+   * into subgroup operations when compiling shaders, and
+   * the reserved UAV is not accessed by those shaders.
+   * Only affects shaders created after this call.
+   * \param [in] UavSlot UAV slot reserved for intrinsics
+   * \param [in] pfnScan Scan callback, or \c nullptr to
+   *    remove a previously installed hook
+   * \param [in] pUserData User data passed to the callback
+   */
+  virtual void STDMETHODCALLTYPE SetShaderIntrinsicHook(
+          UINT                    UavSlot,
+          PFN_D3D11_VK_SCAN_SHADER_INTRINSICS pfnScan,
+          void*                   pUserData) = 0;
+  
+  /**
+   * \brief Enables or disables the UAV binding filter
+   * 
+   * While enabled, UAV bindings to the given slot are
+   * not applied to draws and dispatches whose shaders
+   * all released the slot through the intrinsic scan
+   * callback, on all contexts of the device. Shaders
+   * created before the intrinsic hook was installed, or
+   * that still access the UAV, keep the binding. Used
+   * for the slot reserved for shader intrinsics, which
+   * apps fill with a placeholder UAV.
+   * \param [in] UavSlot UAV slot to filter
+   * \param [in] Enable Whether to enable the filter
+   */
+  virtual void STDMETHODCALLTYPE SetUavBindingFilter(
+          UINT                    UavSlot,
+          BOOL                    Enable) = 0;
+  
+  /**
+   * \brief Queries UAV binding filter statistics
+   * 
+   * The per-frame count refers to the last frame
+   * that was presented on any swap chain.
+   * \param [out] pStats Filter statistics
+   */
+  virtual void STDMETHODCALLTYPE GetUavBindingFilterStats(
+          D3D11_VK_UAV_BINDING_FILTER_STATS* pStats) = 0;
+  
+  /**
+   * \brief Sets a memory placement hint for a resource
+   * 
+   * Resources that prefer host-visible video memory are
+   * moved there if the device exposes such memory, e.g.
+   * with resizable BAR, so that CPU writes go straight to
+   * video memory instead of through a staging copy. The
+   * hint only takes effect the next time the resource is
+   * written, and is ignored if memory is scarce.
+   * \param [in] pResource The resource
+   * \param [in] Placement Preferred placement
+   * \returns \c S_FALSE if the hint was ignored, e.g.
+   *    because the resource cannot be written by the CPU
+   */
+  virtual HRESULT STDMETHODCALLTYPE SetResourcePlacementHint(
+          ID3D11Resource*         pResource,
+          D3D11_VK_RESOURCE_PLACEMENT Placement) = 0;
+  
+  /**
+   * \brief Queries resource placement statistics
+   * 
+   * \c BytesNotStaged counts bytes that CPU writes to
+   * placed resources did not have to copy through a
+   * staging buffer.
+   * \param [out] pStats Placement statistics
+   */
+  virtual void STDMETHODCALLTYPE GetResourcePlacementStats(
+          D3D11_VK_RESOURCE_PLACEMENT_STATS* pStats) = 0;
+  
+};
+
 MIDL_INTERFACE("fd0bca13-5cb6-4c3a-987e-4750de2ca791")
 ID3D11VkExtContext : public IUnknown {
   static const GUID guid;
@@ -71,5 +305,54 @@ ID3D11VkExtContext : public IUnknown {
   
 };
 
+/**
+ * \brief Extended DXVK context interface
+ * 
+ * Exposed by all contexts of devices that
+ * expose \c ID3D11VkExtDevice1.
+ */
+MIDL_INTERFACE("b97365ef-1242-4682-83fe-5c694dc2fe81")
+ID3D11VkExtContext1 : public ID3D11VkExtContext {
+  static const GUID guid;
+  
+  /**
+   * \brief Sets view broadcast masks
+   * 
+   * Subsequent draws are replicated to all viewports and
+   * render target array slices enabled in the masks. This
+   * is implemented through Vulkan multiview where possible
+   * and through instanced viewport index broadcast otherwise.
+   * Setting any mask to zero disables draw replication.
+   * \param [in] ViewportMask Viewport mask
+   * \param [in] RtSliceMask Render target array slice mask
+   * \param [in] ViewportMaskPerRtSlice If \c TRUE, each group
+   *    of 16 bits in the viewport mask applies to 4 array slices.
+   *    Otherwise, the lower 16 bits apply to all slices.
+   */
+  virtual void STDMETHODCALLTYPE SetViewBroadcastMasks(
+          UINT64                  ViewportMask,
+          UINT64                  RtSliceMask,
+          BOOL                    ViewportMaskPerRtSlice) = 0;
+  
+  /**
+   * \brief Sets discard rectangles
+   * 
+   * Maps to \c VK_EXT_discard_rectangles. In inclusive
+   * mode, fragments outside of all rectangles are discarded,
+   * in exclusive mode, fragments inside any rectangle are.
+   * \param [in] NumRects Number of rectangles. Use 0 to
+   *    disable discard rectangles.
+   * \param [in] pRects Rectangles
+   * \param [in] Mode Discard rectangle mode
+   */
+  virtual void STDMETHODCALLTYPE SetDiscardRectangles(
+          UINT                    NumRects,
+    const D3D11_RECT*             pRects,
+          D3D11_VK_DISCARD_RECTANGLE_MODE Mode) = 0;
+  
+};
+
 DXVK_DEFINE_GUID(ID3D11VkExtDevice);
+DXVK_DEFINE_GUID(ID3D11VkExtDevice1);
 DXVK_DEFINE_GUID(ID3D11VkExtContext);
+DXVK_DEFINE_GUID(ID3D11VkExtContext1);
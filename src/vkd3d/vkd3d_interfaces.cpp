@@ -0,0 +1,4 @@
+#include "../ags_private.h"
+
+const GUID ID3D12VkExtDevice::guid      = {0x69333c0c,0x471c,0x4d4c,{0x9d,0x59,0x33,0x59,0x6c,0xb1,0x29,0x5f}};
+const GUID ID3D12VkExtDevice1::guid     = {0xd76295b7,0x82b9,0x4a4d,{0x99,0x4b,0xa0,0xe5,0x39,0xdc,0x5f,0xa3}};
@@ -0,0 +1,155 @@
+#pragma once
+
+#define VKD3D_DEFINE_GUID(iface) \
+  template<> inline GUID const& __mingw_uuidof<iface> () { return iface::guid; }
+
+enum D3D12_VK_EXTENSION : uint32_t {
+  D3D12_VK_EXT_SHADER_INTRINSICS          = 0,
+};
+
+enum D3D12_VK_SHADER_INTRINSIC : uint32_t {
+  D3D12_VK_SHADER_INTRINSIC_READFIRSTLANE       = 0x01,
+  D3D12_VK_SHADER_INTRINSIC_READLANE            = 0x02,
+  D3D12_VK_SHADER_INTRINSIC_LANEID              = 0x03,
+  D3D12_VK_SHADER_INTRINSIC_SWIZZLE             = 0x04,
+  D3D12_VK_SHADER_INTRINSIC_BALLOT              = 0x05,
+  D3D12_VK_SHADER_INTRINSIC_MBCNT               = 0x06,
+  D3D12_VK_SHADER_INTRINSIC_MIN3U               = 0x07,
+  D3D12_VK_SHADER_INTRINSIC_MIN3F               = 0x08,
+  D3D12_VK_SHADER_INTRINSIC_MED3U               = 0x09,
+  D3D12_VK_SHADER_INTRINSIC_MED3F               = 0x0a,
+  D3D12_VK_SHADER_INTRINSIC_MAX3U               = 0x0b,
+  D3D12_VK_SHADER_INTRINSIC_MAX3F               = 0x0c,
+  D3D12_VK_SHADER_INTRINSIC_BARYCOORD           = 0x0d,
+  D3D12_VK_SHADER_INTRINSIC_VTXPARAM            = 0x0e,
+  D3D12_VK_SHADER_INTRINSIC_WAVE_REDUCE         = 0x12,
+  D3D12_VK_SHADER_INTRINSIC_WAVE_SCAN           = 0x13,
+};
+
+struct D3D12_VK_SHADER_INTRINSIC_INSTRUCTION {
+  UINT                        InstructionOffset;
+  D3D12_VK_SHADER_INTRINSIC   Intrinsic;
+  UINT                        Phase;
+  UINT                        Data;
+};
+
+/**
+ * \brief Shader intrinsic info
+ * 
+ * For DXBC shaders, the instructions to translate are
+ * listed explicitly, using the same encoding as the D3D11
+ * intrinsic hook. DXIL shaders carry the intrinsics as
+ * compare-exchange operations with constant arguments,
+ * which the DXIL compiler decodes on its own, so only
+ * the mask of intrinsics that may be translated is set.
+ */
+struct D3D12_VK_SHADER_INTRINSIC_INFO {
+  UINT64                      IntrinsicMask;      ///< Bit \c n is set if intrinsic \c n may be translated
+  UINT                        InstructionCount;   ///< Number of DXBC instructions
+  const D3D12_VK_SHADER_INTRINSIC_INSTRUCTION* pInstructions;
+};
+
+/**
+ * \brief Shader intrinsic query callback
+ * 
+ * Called for each DXBC or DXIL shader that binds a UAV
+ * to the register reserved for shader intrinsics. The
+ * instruction array remains valid until the hook is
+ * removed. May be called from multiple threads.
+ * \returns \c FALSE if the shader does not use any
+ *    intrinsics, in which case \c pInfo is not written
+ */
+typedef BOOL (STDMETHODCALLTYPE *PFN_D3D12_VK_QUERY_SHADER_INTRINSICS)(
+        void*                   pUserData,
+  const void*                   pShaderBytecode,
+        SIZE_T                  BytecodeLength,
+        D3D12_VK_SHADER_INTRINSIC_INFO* pInfo);
+
+struct D3D12_VK_APPLICATION_INFO {
+  const WCHAR*                pApplicationName;
+  UINT                        ApplicationVersion;
+  const WCHAR*                pEngineName;
+  UINT                        EngineVersion;
+};
+
+/**
+ * \brief Registers application info
+ * 
+ * Exported by vkd3d-proton's \c d3d12.dll as
+ * \c VKD3DRegisterApplication. Overrides the names and
+ * versions passed to \c VkApplicationInfo and used for
+ * vkd3d-proton's own profiles for all devices created
+ * after the call. Either name may be \c nullptr.
+ * \param [in] pInfo Application info
+ * \returns \c S_OK on success
+ */
+typedef HRESULT (WINAPI *PFN_VKD3D_REGISTER_APPLICATION)(
+  const D3D12_VK_APPLICATION_INFO* pInfo);
+
+MIDL_INTERFACE("69333c0c-471c-4d4c-9d59-33596cb1295f")
+ID3D12VkExtDevice : public IUnknown {
+  static const GUID guid;
+  
+  /**
+   * \brief Checks whether an extension is supported
+   * 
+   * \param [in] Extension The extension to check
+   * \returns \c TRUE if the extension is supported
+   */
+  virtual BOOL STDMETHODCALLTYPE GetExtensionSupport(
+          D3D12_VK_EXTENSION      Extension) = 0;
+  
+  /**
+   * \brief Checks whether a shader intrinsic is supported
+   * 
+   * \param [in] Intrinsic The intrinsic to check
+   * \returns \c TRUE if the intrinsic can be translated
+   *    on this device, for both DXBC and DXIL shaders
+   */
+  virtual BOOL STDMETHODCALLTYPE GetShaderIntrinsicSupport(
+          D3D12_VK_SHADER_INTRINSIC Intrinsic) = 0;
+  
+  /**
+   * \brief Installs shader intrinsic hook
+   * 
+   * Shaders for which the callback reports intrinsics are
+   * compiled with subgroup operations, and do not access
+   * the reserved UAV. Only affects pipelines created after
+   * this call.
+   * \param [in] RegisterSpace Register space of the reserved UAV
+   * \param [in] UavSlot Register of the reserved UAV
+   * \param [in] pfnQuery Query callback, or \c nullptr to
+   *    remove a previously installed hook
+   * \param [in] pUserData User data passed to the callback
+   */
+  virtual void STDMETHODCALLTYPE SetShaderIntrinsicHook(
+          UINT                    RegisterSpace,
+          UINT                    UavSlot,
+          PFN_D3D12_VK_QUERY_SHADER_INTRINSICS pfnQuery,
+          void*                   pUserData) = 0;
+  
+};
+
+/**
+ * \brief Extended vkd3d-proton device interface
+ */
+MIDL_INTERFACE("d76295b7-82b9-4a4d-994b-a0e539dc5fa3")
+ID3D12VkExtDevice1 : public ID3D12VkExtDevice {
+  static const GUID guid;
+  
+  /**
+   * \brief Checks whether debug labels are consumed
+   * 
+   * Capture and profiling tools such as RenderDoc or PIX
+   * usually attach to vkd3d-proton as Vulkan layers rather
+   * than by hooking D3D12, so only the device knows whether
+   * anything records command buffer labels.
+   * \returns \c TRUE if \c VK_EXT_debug_utils is enabled
+   *    and labels reach a layer or tool
+   */
+  virtual BOOL STDMETHODCALLTYPE GetDebugUtilsConsumerActive() = 0;
+  
+};
+
+VKD3D_DEFINE_GUID(ID3D12VkExtDevice);
+VKD3D_DEFINE_GUID(ID3D12VkExtDevice1);
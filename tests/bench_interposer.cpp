@@ -0,0 +1,141 @@
+#include <cstdio>
+
+#include "ags_interposer.h"
+
+namespace {
+
+  constexpr uint32_t BenchIterations = 1000000;
+  
+  // Large and full of locks and atomics, so it does
+  // not go on the stack. Value-initialized, which
+  // leaves every optional feature disabled.
+  AGSContext g_context = { };
+  
+  
+  double benchTicksToNs(
+          LONGLONG                      ticks) {
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    
+    return double(ticks) * 1.0e9 / double(freq.QuadPart) / double(BenchIterations);
+  }
+  
+  
+  template<typename Fn>
+  double benchRun(
+          ID3D11DeviceContext*          ctx,
+    const Fn&                           fn) {
+    // Warm up, so that the first run does not pay
+    // for lazy allocations in the driver
+    for (uint32_t i = 0; i < BenchIterations / 16; i++)
+      fn(ctx, i);
+    
+    ctx->Flush();
+    
+    LARGE_INTEGER t0, t1;
+    QueryPerformanceCounter(&t0);
+    
+    for (uint32_t i = 0; i < BenchIterations; i++)
+      fn(ctx, i);
+    
+    QueryPerformanceCounter(&t1);
+    
+    ctx->Flush();
+    return benchTicksToNs(t1.QuadPart - t0.QuadPart);
+  }
+  
+  
+  template<typename Fn>
+  void benchCase(
+    const char*                         name,
+          ID3D11DeviceContext*          direct,
+          ID3D11DeviceContext*          wrapped,
+    const Fn&                           fn) {
+    double directNs  = benchRun(direct, fn);
+    double wrappedNs = benchRun(wrapped, fn);
+    
+    std::printf("%-32s %8.2f ns %8.2f ns %+8.2f ns\n", name,
+      directNs, wrappedNs, wrappedNs - directNs);
+  }
+
+}
+
+
+int main() {
+  ID3D11Device* device = nullptr;
+  ID3D11DeviceContext* direct = nullptr;
+  
+  HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE,
+    nullptr, 0, nullptr, 0, D3D11_SDK_VERSION, &device, nullptr, &direct);
+  
+  // Not a failure, we just cannot measure anything
+  if (FAILED(hr)) {
+    std::fprintf(stderr, "Failed to create D3D11 device: %08x\n", unsigned(hr));
+    return 77;
+  }
+  
+  ID3D11DeviceContext4* ctx = nullptr;
+  
+  if (FAILED(direct->QueryInterface(IID_PPV_ARGS(&ctx)))) {
+    std::fprintf(stderr, "ID3D11DeviceContext4 not supported\n");
+    direct->Release();
+    device->Release();
+    return 77;
+  }
+  
+  // Go through QueryInterface so that the calls below are
+  // dispatched through the vtable, the same way games do
+  AgsDeviceContext* interposer = new AgsDeviceContext(&g_context, ctx);
+  ID3D11DeviceContext* wrapped = nullptr;
+  interposer->QueryInterface(IID_PPV_ARGS(&wrapped));
+  interposer->Release();
+  
+  D3D11_BUFFER_DESC desc = { };
+  desc.ByteWidth = 16;
+  desc.Usage     = D3D11_USAGE_DEFAULT;
+  desc.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS;
+  
+  ID3D11Buffer* buffer = nullptr;
+  
+  if (FAILED(device->CreateBuffer(&desc, nullptr, &buffer))) {
+    std::fprintf(stderr, "Failed to create buffer\n");
+    return 1;
+  }
+  
+  std::printf("%-32s %11s %11s %11s\n", "Call", "Direct", "Wrapped", "Overhead");
+  
+  benchCase("IASetPrimitiveTopology", direct, wrapped,
+    [] (ID3D11DeviceContext* ctx, uint32_t i) {
+      ctx->IASetPrimitiveTopology((i & 1)
+        ? D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+        : D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    });
+  
+  benchCase("Draw", direct, wrapped,
+    [] (ID3D11DeviceContext* ctx, uint32_t i) {
+      ctx->Draw(3, i & 0xff);
+    });
+  
+  benchCase("UpdateSubresource", direct, wrapped,
+    [buffer] (ID3D11DeviceContext* ctx, uint32_t i) {
+      uint32_t data[4] = { i, 1, 0, 0 };
+      ctx->UpdateSubresource(buffer, 0, nullptr, data, 0, 0);
+    });
+  
+  // Same call, but the buffer is now a known draw count
+  // buffer, so every write gets shadowed on the CPU
+  g_context.drawCountShadowing = true;
+  g_context.drawCountBuffers.insert(buffer);
+  
+  benchCase("UpdateSubresource (shadowed)", direct, wrapped,
+    [buffer] (ID3D11DeviceContext* ctx, uint32_t i) {
+      uint32_t data[4] = { i, 1, 0, 0 };
+      ctx->UpdateSubresource(buffer, 0, nullptr, data, 0, 0);
+    });
+  
+  buffer->Release();
+  wrapped->Release();
+  direct->Release();
+  device->Release();
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // Modules that must only be loaded once the app
+  // actually creates a device through AGS
+  const char* const ForbiddenImports[] = {
+    "d3d11.dll",
+    "dxgi.dll",
+  };
+  
+  // Static constructor that libstdc++ pulls in
+  // whenever anything uses iostreams
+  const char* const IosInitSymbol = "_ZNSt8ios_base4InitC1Ev";
+  
+  constexpr uint32_t PeSectionDiscardable = 0x02000000u;
+  
+  uint32_t g_failures = 0;
+  
+  
+  void check(
+          bool                          condition,
+    const std::string&                  what) {
+    if (!condition) {
+      std::fprintf(stderr, "FAIL: %s\n", what.c_str());
+      g_failures += 1;
+    }
+  }
+  
+  
+  /**
+   * \brief Minimal PE image reader
+   *
+   * Only understands what the checks below need. Reads
+   * outside of the file return zero, so a broken image
+   * shows up as failed checks rather than a crash.
+   */
+  struct PeImage {
+    std::vector<uint8_t> data;
+    uint32_t coffHeader = 0;
+    uint32_t optHeader  = 0;
+    uint32_t sections   = 0;
+    uint32_t numSections = 0;
+    
+    template<typename T>
+    T read(uint64_t offset) const {
+      T value = T();
+      
+      if (offset + sizeof(T) <= data.size())
+        std::memcpy(&value, &data[offset], sizeof(T));
+      
+      return value;
+    }
+    
+    std::string readString(uint64_t offset) const {
+      std::string result;
+      
+      while (offset < data.size() && data[offset])
+        result += char(data[offset++]);
+      
+      return result;
+    }
+    
+    bool parse() {
+      uint32_t peHeader = read<uint32_t>(0x3c);
+      
+      if (read<uint16_t>(0) != 0x5a4d || read<uint32_t>(peHeader) != 0x00004550)
+        return false;
+      
+      coffHeader  = peHeader + 4;
+      optHeader   = coffHeader + 20;
+      numSections = read<uint16_t>(coffHeader + 2);
+      sections    = optHeader + read<uint16_t>(coffHeader + 16);
+      
+      // Only PE32+, since we only ship a 64-bit DLL
+      return read<uint16_t>(optHeader) == 0x20b;
+    }
+    
+    uint32_t sectionHeader(uint32_t index) const {
+      return sections + 40 * index;
+    }
+    
+    uint64_t rvaToOffset(uint32_t rva) const {
+      for (uint32_t i = 0; i < numSections; i++) {
+        uint32_t header = sectionHeader(i);
+        uint32_t va     = read<uint32_t>(header + 12);
+        uint32_t size   = read<uint32_t>(header + 16);
+        
+        if (rva >= va && rva < va + size)
+          return uint64_t(read<uint32_t>(header + 20)) + (rva - va);
+      }
+      
+      return ~uint64_t(0);
+    }
+    
+    std::vector<std::string> imports() const {
+      std::vector<std::string> result;
+      
+      if (read<uint32_t>(optHeader + 108) < 2)
+        return result;
+      
+      uint64_t descriptor = rvaToOffset(read<uint32_t>(optHeader + 120));
+      
+      while (descriptor < data.size()) {
+        uint32_t name = read<uint32_t>(descriptor + 12);
+        
+        if (!name)
+          break;
+        
+        result.push_back(readString(rvaToOffset(name)));
+        descriptor += 20;
+      }
+      
+      return result;
+    }
+    
+    uint64_t loadedSize() const {
+      uint64_t size = 0;
+      
+      for (uint32_t i = 0; i < numSections; i++) {
+        uint32_t header = sectionHeader(i);
+        
+        if (!(read<uint32_t>(header + 36) & PeSectionDiscardable))
+          size += read<uint32_t>(header + 8);
+      }
+      
+      return size;
+    }
+    
+    bool hasSymbolTable() const {
+      return read<uint32_t>(coffHeader + 8) != 0;
+    }
+    
+    bool hasSymbol(const char* name) const {
+      // Long names live in the string table right after
+      // the symbol table, which is all we need to scan
+      uint64_t begin = uint64_t(read<uint32_t>(coffHeader + 8))
+                     + uint64_t(read<uint32_t>(coffHeader + 12)) * 18;
+      
+      if (begin >= data.size())
+        return false;
+      
+      size_t length = std::strlen(name) + 1;
+      
+      return std::search(data.begin() + begin, data.end(),
+        name, name + length) != data.end();
+    }
+  };
+  
+  
+  std::string toLower(std::string str) {
+    for (auto& c : str)
+      c = (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+    
+    return str;
+  }
+
+}
+
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::fprintf(stderr, "Usage: %s <dll> <max loaded size>\n", argv[0]);
+    return 1;
+  }
+  
+  PeImage image;
+  
+  std::ifstream file(argv[1], std::ios::binary);
+  image.data.assign(std::istreambuf_iterator<char>(file),
+    std::istreambuf_iterator<char>());
+  
+  if (!image.parse()) {
+    std::fprintf(stderr, "%s: Not a PE32+ image\n", argv[1]);
+    return 1;
+  }
+  
+  for (const auto& name : image.imports()) {
+    std::printf("Import: %s\n", name.c_str());
+    
+    for (const char* forbidden : ForbiddenImports)
+      check(toLower(name) != forbidden, "imports " + name);
+  }
+  
+  uint64_t maxSize = std::strtoull(argv[2], nullptr, 0);
+  uint64_t size = image.loadedSize();
+  
+  std::printf("Loaded size: %llu bytes, limit %llu bytes\n",
+    static_cast<unsigned long long>(size),
+    static_cast<unsigned long long>(maxSize));
+  
+  check(size <= maxSize, "loaded size exceeds " + std::to_string(maxSize) + " bytes");
+  
+  // Stripped images cannot be checked, which is fine
+  // since meson only strips the DLL on install
+  if (image.hasSymbolTable())
+    check(!image.hasSymbol(IosInitSymbol), "links iostream initialisers");
+  else
+    std::printf("No symbol table, skipping iostream check\n");
+  
+  if (g_failures) {
+    std::fprintf(stderr, "%u checks failed\n", g_failures);
+    return 1;
+  }
+  
+  return 0;
+}
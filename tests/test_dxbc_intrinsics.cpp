@@ -0,0 +1,434 @@
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "dxbc_intrinsics.h"
+
+namespace {
+
+  constexpr uint32_t TestSpace = 0x7fff0ade;
+  
+  // Operand tokens, see d3d11tokenizedprogramformat.hpp
+  constexpr uint32_t TokTempDst       = 0x00100012; // r#.x
+  constexpr uint32_t TokTempSrc       = 0x0010000a; // r#.x
+  constexpr uint32_t TokUavDst50      = 0x0011e012; // u#.x
+  constexpr uint32_t TokUavDst51      = 0x0021e012; // U#[#].x
+  constexpr uint32_t TokUavDst51Rel   = 0x0621e012; // U#[# + r#.x].x
+  constexpr uint32_t TokUavSrc50      = 0x0011ee46; // u#.xyzw
+  constexpr uint32_t TokUavDcl50      = 0x0011e000; // u#
+  constexpr uint32_t TokUavDcl51      = 0x0031e000; // U#[#:#]
+  constexpr uint32_t TokImm32         = 0x00004001; // l(#)
+  
+  constexpr uint32_t OpRet            = 0x0100003e;
+  constexpr uint32_t OpDclUavRaw50    = 0x0300009d;
+  constexpr uint32_t OpDclUavRaw51    = 0x0600009d;
+  constexpr uint32_t OpCmpExch50      = 0x0b0000b9;
+  constexpr uint32_t OpCmpExch51      = 0x0c0000b9;
+  constexpr uint32_t OpStoreRaw50     = 0x070000a6;
+  constexpr uint32_t OpStoreRaw51Rel  = 0x0a0000a6;
+  constexpr uint32_t OpLdUavTyped50   = 0x070000a3;
+  constexpr uint32_t OpDclGsInstances = 0x020000ce;
+  constexpr uint32_t OpCustomData     = 0x00000035;
+  
+  uint32_t g_failures = 0;
+  
+  
+  void check(
+          bool                          condition,
+    const char*                         what,
+          int                           line) {
+    if (!condition) {
+      std::fprintf(stderr, "FAIL line %d: %s\n", line, what);
+      g_failures += 1;
+    }
+  }
+  
+  #define CHECK(cond) check(cond, #cond, __LINE__)
+  
+  
+  /**
+   * \brief Encodes an intrinsic like the AGS shader headers
+   */
+  uint32_t amdEncode(
+          uint32_t                      opcode,
+          uint32_t                      data,
+          uint32_t                      phase) {
+    return (0x5u << 28) | (phase << 24) | (data << 8) | opcode;
+  }
+  
+  
+  /**
+   * \brief Shader program builder
+   *
+   * Fills in the program length when done.
+   */
+  struct Program {
+    std::vector<uint32_t> tokens;
+    
+    explicit Program(uint32_t version)
+    : tokens({ version, 0u }) { }
+    
+    uint32_t offset() const {
+      return uint32_t(tokens.size());
+    }
+    
+    void emit(std::initializer_list<uint32_t> list) {
+      tokens.insert(tokens.end(), list);
+    }
+    
+    std::vector<uint32_t> finish() {
+      tokens[1] = uint32_t(tokens.size());
+      return tokens;
+    }
+  };
+  
+  
+  void emitCmpExch50(
+          Program&                      program,
+          uint32_t                      slot,
+          uint32_t                      addr) {
+    program.emit({ OpCmpExch50,
+      TokTempDst, 0,
+      TokUavDst50, slot,
+      TokImm32, addr,
+      TokImm32, 0,
+      TokImm32, 0 });
+  }
+  
+  
+  void emitCmpExch51(
+          Program&                      program,
+          uint32_t                      rangeId,
+          uint32_t                      slot,
+          uint32_t                      addr) {
+    program.emit({ OpCmpExch51,
+      TokTempDst, 0,
+      TokUavDst51, rangeId, slot,
+      TokImm32, addr,
+      TokImm32, 0,
+      TokImm32, 0 });
+  }
+  
+  
+  /**
+   * \brief Wraps a chunk into a DXBC container
+   */
+  std::vector<uint8_t> makeContainer(
+    const char*                         name,
+    const std::vector<uint32_t>&        data) {
+    std::vector<uint8_t> result(44 + 4 * data.size());
+    
+    auto writeDword = [&result] (size_t offset, uint32_t value) {
+      std::memcpy(&result[offset], &value, sizeof(value));
+    };
+    
+    std::memcpy(&result[0], "DXBC", 4);
+    writeDword(20, 1);
+    writeDword(24, uint32_t(result.size()));
+    writeDword(28, 1);
+    writeDword(32, 36);
+    std::memcpy(&result[36], name, 4);
+    writeDword(40, uint32_t(4 * data.size()));
+    std::memcpy(&result[44], data.data(), 4 * data.size());
+    return result;
+  }
+  
+  
+  bool scan(
+    const std::vector<uint8_t>&         container,
+          uint32_t                      space,
+          uint32_t                      slot,
+          std::vector<DxbcIntrinsic>&   intrinsics,
+          uint32_t*                     pAccessCount) {
+    return dxbcScanIntrinsics(container.data(), container.size(),
+      space, slot, intrinsics, pAccessCount);
+  }
+  
+  
+  void testAllOpcodes() {
+    static const uint32_t opcodes[] = {
+      DxbcIntrinsicReadfirstlane, DxbcIntrinsicReadlane,
+      DxbcIntrinsicLaneId,        DxbcIntrinsicSwizzle,
+      DxbcIntrinsicBallot,        DxbcIntrinsicMBCnt,
+      DxbcIntrinsicMin3U,         DxbcIntrinsicMin3F,
+      DxbcIntrinsicMed3U,         DxbcIntrinsicMed3F,
+      DxbcIntrinsicMax3U,         DxbcIntrinsicMax3F,
+      DxbcIntrinsicBaryCoord,     DxbcIntrinsicVtxParam,
+      DxbcIntrinsicWaveReduce,    DxbcIntrinsicWaveScan,
+    };
+    
+    Program program(0x00050050);
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 7 });
+    
+    // Custom data blocks must be skipped as a whole
+    program.emit({ OpCustomData, 6, 0, 0, 0, 0 });
+    
+    std::vector<DxbcIntrinsic> expected;
+    
+    for (uint32_t opcode : opcodes) {
+      for (uint32_t phase = 0; phase < 4; phase++) {
+        uint32_t data = (opcode << 4) | phase;
+        
+        if (opcode == DxbcIntrinsicWaveScan)
+          data = DxbcIntrinsicWaveOpMaxF | (DxbcIntrinsicWaveScanExclusive << 8);
+        
+        expected.push_back({ program.offset(), opcode, phase, data });
+        emitCmpExch50(program, 7, amdEncode(opcode, data, phase));
+      }
+    }
+    
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = 0;
+    
+    CHECK(scan(container, 0, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == expected.size());
+    CHECK(accessCount == expected.size());
+    
+    for (size_t i = 0; i < intrinsics.size() && i < expected.size(); i++) {
+      CHECK(intrinsics[i].offset == expected[i].offset);
+      CHECK(intrinsics[i].opcode == expected[i].opcode);
+      CHECK(intrinsics[i].phase  == expected[i].phase);
+      CHECK(intrinsics[i].data   == expected[i].data);
+    }
+    
+    // SM 5.0 shaders do not have any other register space
+    CHECK(scan(container, TestSpace, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.empty());
+    CHECK(accessCount == 0);
+  }
+  
+  
+  void testShdrChunk() {
+    Program program(0x00040040);
+    uint32_t offset = program.offset();
+    emitCmpExch50(program, 7, amdEncode(DxbcIntrinsicLaneId, 0, 0));
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHDR", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    
+    CHECK(scan(container, 0, 7, intrinsics, nullptr));
+    CHECK(intrinsics.size() == 1);
+    CHECK(intrinsics.size() == 1 && intrinsics[0].offset == offset);
+  }
+  
+  
+  void testRegisterSpace() {
+    Program program(0x00050051);
+    program.emit({ OpDclUavRaw51, TokUavDcl51, 3, 0, 0, TestSpace });
+    program.emit({ OpDclUavRaw51, TokUavDcl51, 4, 0, 0, 0 });
+    
+    uint32_t offset = program.offset();
+    emitCmpExch51(program, 3, 0, amdEncode(DxbcIntrinsicReadfirstlane, 0, 0));
+    emitCmpExch51(program, 4, 0, amdEncode(DxbcIntrinsicReadlane, 0, 0));
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = 0;
+    
+    // Only the range in the intrinsic space counts
+    CHECK(scan(container, TestSpace, 0, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(accessCount == 1);
+    
+    if (intrinsics.size() == 1) {
+      CHECK(intrinsics[0].offset == offset);
+      CHECK(intrinsics[0].opcode == DxbcIntrinsicReadfirstlane);
+    }
+    
+    CHECK(scan(container, 0, 0, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(intrinsics.size() == 1 && intrinsics[0].opcode == DxbcIntrinsicReadlane);
+    
+    // Dynamically indexed ranges covering the slot may access
+    // the UAV, but never count as intrinsics themselves
+    Program dynamic(0x00050051);
+    dynamic.emit({ OpDclUavRaw51, TokUavDcl51, 3, 0, 15, TestSpace });
+    emitCmpExch51(dynamic, 3, 7, amdEncode(DxbcIntrinsicBallot, 0, 0));
+    dynamic.emit({ OpStoreRaw51Rel,
+      TokUavDst51Rel, 3, 0, TokTempSrc, 0,
+      TokImm32, 0,
+      TokImm32, 0 });
+    dynamic.emit({ OpRet });
+    
+    container = makeContainer("SHEX", dynamic.finish());
+    
+    CHECK(scan(container, TestSpace, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(accessCount == 2);
+    
+    CHECK(scan(container, TestSpace, 16, intrinsics, &accessCount));
+    CHECK(intrinsics.empty());
+    CHECK(accessCount == 0);
+  }
+  
+  
+  void testWrongSlot() {
+    Program program(0x00050050);
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 6 });
+    emitCmpExch50(program, 6, amdEncode(DxbcIntrinsicBallot, 0, 0));
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = ~0u;
+    
+    CHECK(scan(container, 0, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.empty());
+    CHECK(accessCount == 0);
+  }
+  
+  
+  void testOtherAccess() {
+    Program program(0x00050050);
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 7 });
+    emitCmpExch50(program, 7, amdEncode(DxbcIntrinsicBallot, 0, 0));
+    
+    // Regular atomic without the magic code
+    emitCmpExch50(program, 7, 0x1234);
+    
+    program.emit({ OpStoreRaw50,
+      TokUavDst50, 7,
+      TokImm32, 0,
+      TokImm32, 0 });
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = 0;
+    
+    CHECK(scan(container, 0, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(accessCount == 3);
+  }
+  
+  
+  void testTypedLoad() {
+    // ld_uav_typed directly follows the last SM5 declaration
+    Program program(0x00050050);
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 7 });
+    emitCmpExch50(program, 7, amdEncode(DxbcIntrinsicBallot, 0, 0));
+    program.emit({ OpLdUavTyped50,
+      TokTempDst, 0,
+      TokImm32, 0,
+      TokUavSrc50, 7 });
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = 0;
+    
+    CHECK(scan(container, 0, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(accessCount == 2);
+  }
+  
+  
+  void testGsInstanceCount() {
+    Program program(0x00020050);
+    program.emit({ OpDclGsInstances, 4 });
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 7 });
+    
+    uint32_t offset = program.offset();
+    emitCmpExch50(program, 7, amdEncode(DxbcIntrinsicLaneId, 0, 0));
+    program.emit({ OpRet });
+    
+    auto container = makeContainer("SHEX", program.finish());
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    uint32_t accessCount = 0;
+    
+    CHECK(scan(container, 0, 7, intrinsics, &accessCount));
+    CHECK(intrinsics.size() == 1);
+    CHECK(intrinsics.size() == 1 && intrinsics[0].offset == offset);
+    CHECK(accessCount == 1);
+  }
+  
+  
+  void testTruncated() {
+    Program program(0x00050050);
+    program.emit({ OpDclUavRaw50, TokUavDcl50, 7 });
+    emitCmpExch50(program, 7, amdEncode(DxbcIntrinsicBallot, 0, 0));
+    program.emit({ OpRet });
+    
+    auto tokens = program.finish();
+    auto container = makeContainer("SHEX", tokens);
+    
+    std::vector<DxbcIntrinsic> intrinsics;
+    
+    // Container shorter than its chunk
+    auto truncated = container;
+    truncated.resize(truncated.size() - 8);
+    CHECK(!scan(truncated, 0, 7, intrinsics, nullptr));
+    CHECK(intrinsics.empty());
+    
+    // Container shorter than its header
+    truncated.resize(20);
+    CHECK(!scan(truncated, 0, 7, intrinsics, nullptr));
+    
+    // Program longer than the chunk
+    tokens[1] += 1;
+    CHECK(!scan(makeContainer("SHEX", tokens), 0, 7, intrinsics, nullptr));
+    
+    // Instruction that runs past the end of the program
+    tokens[1] -= 1;
+    tokens.back() = OpCmpExch50;
+    CHECK(!scan(makeContainer("SHEX", tokens), 0, 7, intrinsics, nullptr));
+    
+    // No program chunk at all
+    CHECK(!scan(makeContainer("RDEF", tokens), 0, 7, intrinsics, nullptr));
+    CHECK(!dxbcScanIntrinsics(nullptr, 0, 0, 7, intrinsics, nullptr));
+  }
+  
+  
+  void testDxil() {
+    // Runtime info size, runtime info, resource count, binding
+    // size, then type, space, lower and upper bound per binding
+    std::vector<uint32_t> psv = { 4, 0, 2, 16,
+      2, 0, 0, 0,
+      7, TestSpace, 0, 3 };
+    
+    auto container = makeContainer("PSV0", psv);
+    
+    CHECK(!dxbcIsDxil(container.data(), container.size()));
+    CHECK(dxilHasIntrinsicUav(container.data(), container.size(), TestSpace, 0));
+    CHECK(dxilHasIntrinsicUav(container.data(), container.size(), TestSpace, 3));
+    CHECK(!dxilHasIntrinsicUav(container.data(), container.size(), TestSpace, 4));
+    CHECK(!dxilHasIntrinsicUav(container.data(), container.size(), 0, 0));
+    
+    container = makeContainer("DXIL", { 0 });
+    CHECK(dxbcIsDxil(container.data(), container.size()));
+  }
+
+}
+
+
+int main() {
+  testAllOpcodes();
+  testShdrChunk();
+  testRegisterSpace();
+  testWrongSlot();
+  testOtherAccess();
+  testTypedLoad();
+  testGsInstanceCount();
+  testTruncated();
+  testDxil();
+  
+  if (g_failures) {
+    std::fprintf(stderr, "%u checks failed\n", g_failures);
+    return 1;
+  }
+  
+  return 0;
+}